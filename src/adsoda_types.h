@@ -10,6 +10,11 @@
 //#define VERY_SMALL_NUM	1E-15
 #define VERY_SMALL_NUM	1E-5
 
+//  Half the width of a box much larger than any Solid, which the double description
+//  starts from and linear programs are bounded by.  Every corner of a Solid must lie
+//  well inside this box.
+#define BOUNDING_BOX_SIZE	1E6
+
 #include <iostream>
 
 
@@ -30,4 +35,11 @@ enum
 	NEITHER
 	};
 
+enum
+	{
+	INSIDE,
+	OUTSIDE,
+	STRADDLING
+	};
+
 #endif
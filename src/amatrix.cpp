@@ -36,7 +36,7 @@ AMatrix::AMatrix(long pnumRows, long pnumColumns)
   ASSERT(elements != NULL);
 
   // Allocate space for all rows
-  register long row;
+  long row;
   for (row = 0; row < numRows; row++) {
     elements[row] = (double *) malloc(numColumns * sizeof(double));
     ASSERT(elements[row] != NULL);
@@ -66,7 +66,7 @@ AMatrix::AMatrix(const AMatrix &AMatrix)
   ASSERT(elements != NULL);
 
   // Allocate space for all rows, and copy them from AMatrix
-  register long row;
+  long row;
   for (row = 0; row < numRows; row++) {
     elements[row] = (double *)malloc(numColumns * sizeof(double));
     ASSERT(elements[row] != NULL);
@@ -90,7 +90,7 @@ AMatrix::~AMatrix(void)
 {
 
   // Free memory used by rows
-  register long row;
+  long row;
   for (row = 0; row < numRows; row++)
     free(elements[row]);
 
@@ -114,12 +114,12 @@ void AMatrix::MakeIdentity(void)
 {
 
   // Set all elements to e(i,j)
-  register long row;
-  register long column;
+  long row;
+  long column;
   for (row = 0; row < numRows; row++) {
 
     //  Get pointer to first element of row
-    register double *thisElement = elements[row];
+    double *thisElement = elements[row];
 
     // Fill in this row
     for (column = 0; column < numColumns; column++) {
@@ -151,6 +151,53 @@ void AMatrix::Invert(void)
 
 
 
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| AMatrix::IsConformal
+//|
+//| Purpose: This method checks whether this AMatrix is a rotation or reflection,
+//|          possibly with the same scale in every direction; that is, whether
+//|          its columns are orthogonal and all of the same length.  Such a matrix
+//|          keeps angles, so it maps normals the same way it maps points.  This
+//|          AMatrix should be square.
+//|
+//| Parameters: returns true if this AMatrix is conformal
+//|_________________________________________________________________________________
+
+bool AMatrix::IsConformal(void) const
+{
+
+  // The dot product of the first column with itself is the square of the scale
+  double scale = 0.0;
+  long row;
+  for (row = 0; row < numRows; row++)
+    scale += elements[row][0] * elements[row][0];
+
+  if (scale <= VERY_SMALL_NUM)
+    return false;
+
+  // The dot products of the columns must be scale times the identity
+  long column1, column2;
+  for (column1 = 0; column1 < numColumns; column1++)
+    for (column2 = column1; column2 < numColumns; column2++) {
+
+      double dot = 0.0;
+      for (row = 0; row < numRows; row++)
+	dot += elements[row][column1] * elements[row][column2];
+
+      if (column1 == column2)
+	dot -= scale;
+
+      if (fabs(dot) > VERY_SMALL_NUM * scale)
+	return false;
+
+    }
+
+  return true;
+
+}  //==== AMatrix::IsConformal() ====//
+
+
+
 //|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //| AMatrix::Determinant
 //|
@@ -183,13 +230,13 @@ double AMatrix::Determinant(void)
 
 void AMatrix::operator = (const AMatrix& m) {
 
-  register long row;
-  register long column;
+  long row;
+  long column;
   for (row = 0; row < m.numRows; row++) {
 
     // Get pointers to one row of AMatrix and this
-    register double *mElement = m.elements[row];
-    register double *thisElement = elements[row];
+    double *mElement = m.elements[row];
+    double *thisElement = elements[row];
   
     // Copy all entries in this row
     for (column = 0; column < m.numColumns; column++) {
@@ -225,12 +272,12 @@ AMatrix operator + (const AMatrix &m1, const AMatrix &m2)
   AMatrix sum(m1.numRows, m1.numColumns);
 	
   // Add all elements elementwise, and store the result in sum
-  register long row;
-  register long column;
+  long row;
+  long column;
   for (row = 0; row < m1.numRows; row++) {
-    register double *m1Element = m1.elements[row];
-    register double *m2Element = m2.elements[row];
-    register double *sumElement = sum.elements[row];
+    double *m1Element = m1.elements[row];
+    double *m2Element = m2.elements[row];
+    double *sumElement = sum.elements[row];
 		
     for (column = 0; column < m1.numColumns; column++) {
       *sumElement = *m1Element + *m2Element;
@@ -267,13 +314,13 @@ AMatrix operator - (AMatrix& m1, AMatrix& m2)
   AMatrix difference(m1.numRows, m1.numColumns);
 	
   // Subtract m2 from m1 elementwise, and store result in different
-  register long row;
-  register long column;
+  long row;
+  long column;
   for (row = 0; row < m1.numRows; row++) {
 
-    register double *m1Element = m1.elements[row];
-    register double *m2Element = m2.elements[row];
-    register double *differenceElement = difference.elements[row];
+    double *m1Element = m1.elements[row];
+    double *m2Element = m2.elements[row];
+    double *differenceElement = difference.elements[row];
 		
     for (column = 0; column < m1.numColumns; column++) {
 
@@ -312,15 +359,15 @@ AMatrix operator *(const AMatrix& m1, const AMatrix& m2)
   AMatrix product(m1.numRows, m2.numColumns);
 	
   // Compute m1*m2 (AMatrix multiplication), and store the result in product
-  register long row;
-  register long column;
+  long row;
+  long column;
   for (row = 0; row < m1.numRows; row++) {
     
     for (column = 0; column < m2.numColumns; column++) {
 
-      register double sum = 0;
+      double sum = 0;
 
-      register long i;
+      long i;
       for (i = 0; i < m1.numColumns; i++)
 	sum += m1.elements[row][i] * m2.elements[i][column];
 
@@ -354,12 +401,12 @@ Vector operator * (const AMatrix& m, const Vector& v)
   Vector product(m.numRows);
 	
   // Multiply m*v, and store the result in product
-  register long row;
+  long row;
   for (row = 0; row < m.numRows; row++) {
 
-    register double sum = 0;
+    double sum = 0;
     
-    register long i;
+    long i;
     for (i = 0; i < v.Dimension(); i++)
       sum += m.elements[row][i] * v.coordinates[i];
     
@@ -390,12 +437,12 @@ AMatrix operator * (double s, const AMatrix& m)
   AMatrix product(m.numRows, m.numColumns);
 	
   // Compute s*m, and put result in product
-  register long row;
-  register long column;
+  long row;
+  long column;
   for (row = 0; row < m.numRows; row++) {
     
-    register double *mElement = m.elements[row];
-    register double *productElement = product.elements[row];
+    double *mElement = m.elements[row];
+    double *productElement = product.elements[row];
     
     for (column = 0; column < m.numColumns; column++) {
       
@@ -430,12 +477,12 @@ AMatrix operator - (const AMatrix& m)
   AMatrix negative(m.numRows, m.numColumns);
 	
   // Negate m, and put the result in negative
-  register long row;
-  register long column;
+  long row;
+  long column;
   for (row = 0; row < m.numRows; row++) {
     
-    register double *mElement = m.elements[row];
-    register double *negativeElement = negative.elements[row];
+    double *mElement = m.elements[row];
+    double *negativeElement = negative.elements[row];
 		
     for (column = 0; column < m.numColumns; column++) {
 
@@ -475,8 +522,8 @@ void AMatrix::CreateRotationMatrix(long axis1, long axis2, double angle)
   // Make this the identity matrix
   MakeIdentity();
   
-  register double sin_angle = sin(angle);
-  register double cos_angle = cos(angle);
+  double sin_angle = sin(angle);
+  double cos_angle = cos(angle);
 
   // Change four elements to make this a standard rotation matrix
   elements[axis1-1][axis1-1] = cos_angle;
@@ -502,12 +549,12 @@ void AMatrix::CreateRotationMatrix(long axis1, long axis2, double angle)
 void AMatrix::CreateScaleMatrix(const Vector& scaleVector)
 {
  
-  register long row;
-  register long column;
+  long row;
+  long column;
   for (row = 0; row < numRows; row++) {
 
     // Get pointer to first element of row
-    register double *thisElement = elements[row];
+    double *thisElement = elements[row];
   
     // Make the diagonals scale factors
     for (column = 0; column < numColumns; column++) {
@@ -28,6 +28,7 @@ public:
   void MakeIdentity();
   void Invert(void);
   double Determinant(void);
+  bool IsConformal(void) const;
 
   void operator= (const AMatrix &m);
   
@@ -0,0 +1,452 @@
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Arena.cpp
+//|
+//| This is the implementation of the frame arena.
+//|_____________________________________________________________________________
+
+#include "arena.h"
+#include "adsoda_types.h"
+
+#include <new>
+#include <stdlib.h>
+
+
+//  The one frame arena
+FrameArena FrameArena::frame_arena;
+
+
+//
+//  Every object allocated by AllocateObject is preceded by an ObjectHeader which
+//  remembers where its memory came from, so FreeObject can give it back there.
+//  The header keeps the object aligned as well as new would.
+//
+
+class alignas(16) ObjectHeader
+{
+
+public:
+
+  std::pmr::memory_resource *resource;
+  size_t size;
+
+};
+
+
+//
+//  Releases the ThreadArena claimed by a thread when the thread ends, so a
+//  later thread can use it.  The arena itself stays, since things made from
+//  it may live until the end of the frame.
+//
+
+class ArenaClaim
+{
+
+public:
+
+  FrameArena::ThreadArena *arena;
+  std::mutex *lock;
+
+  ArenaClaim(void) { arena = NULL; lock = NULL; }
+  ~ArenaClaim(void);
+
+};
+
+static thread_local ArenaClaim arena_claim;
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| FrameArena::ThreadArena::ThreadArena
+//|
+//| Purpose: This method creates the arena for one thread.
+//|
+//| Parameters: none
+//|_________________________________________________________________________________
+
+FrameArena::ThreadArena::ThreadArena(void) :
+
+  blocks(ARENA_BLOCK_SIZE)
+
+{
+
+  allocations = 0;
+  bytes = 0;
+  claimed = false;
+
+} //==== FrameArena::ThreadArena::ThreadArena() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| ArenaClaim::~ArenaClaim
+//|
+//| Purpose: This method gives up the ThreadArena of a thread which is ending.
+//|
+//| Parameters: none
+//|_________________________________________________________________________________
+
+ArenaClaim::~ArenaClaim(void)
+{
+
+  if (arena) {
+    std::lock_guard<std::mutex> guard(*lock);
+    arena->claimed = false;
+  }
+
+} //==== ArenaClaim::~ArenaClaim() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| FrameArena::HeapResource::HeapResource
+//|
+//| Purpose: This method creates the resource which counts heap allocations.
+//|
+//| Parameters: none
+//|_________________________________________________________________________________
+
+FrameArena::HeapResource::HeapResource(void)
+{
+
+  allocations = 0;
+
+} //==== FrameArena::HeapResource::HeapResource() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| FrameArena::HeapResource::do_allocate
+//|
+//| Purpose: This method allocates memory from the heap, and counts it.
+//|
+//| Parameters: bytes:     the size of the memory
+//|             alignment: the alignment of the memory
+//|             returns the memory
+//|_________________________________________________________________________________
+
+void *FrameArena::HeapResource::do_allocate(size_t bytes, size_t alignment)
+{
+
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+
+} //==== FrameArena::HeapResource::do_allocate() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| FrameArena::HeapResource::do_deallocate
+//|
+//| Purpose: This method returns memory to the heap.
+//|
+//| Parameters: p:         the memory
+//|             bytes:     the size of the memory
+//|             alignment: the alignment of the memory
+//|_________________________________________________________________________________
+
+void FrameArena::HeapResource::do_deallocate(void *p, size_t bytes, size_t alignment)
+{
+
+  std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+
+} //==== FrameArena::HeapResource::do_deallocate() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| FrameArena::HeapResource::do_is_equal
+//|
+//| Purpose: This method checks whether memory from another resource can be
+//|          returned to this one.
+//|
+//| Parameters: other: the other resource
+//|             returns true if other is this
+//|_________________________________________________________________________________
+
+bool FrameArena::HeapResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+
+  return (this == &other);
+
+} //==== FrameArena::HeapResource::do_is_equal() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| FrameArena::FrameArena
+//|
+//| Purpose: This method creates the frame arena.  It starts out not in a frame,
+//|          so everything comes from the heap until the first frame begins.
+//|
+//| Parameters: none
+//|_________________________________________________________________________________
+
+FrameArena::FrameArena(void)
+{
+
+  in_frame = false;
+  enabled = true;
+
+} //==== FrameArena::FrameArena() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| FrameArena::GetThreadArena
+//|
+//| Purpose: This method finds the ThreadArena of the calling thread, claiming
+//|          one the first time the thread needs it.
+//|
+//| Parameters: returns the ThreadArena
+//|_________________________________________________________________________________
+
+FrameArena::ThreadArena *FrameArena::GetThreadArena(void)
+{
+
+  if (arena_claim.arena)
+    return arena_claim.arena;
+
+  std::lock_guard<std::mutex> guard(lock);
+
+  //  Use an arena left by a thread which has ended, or make a new one
+  ThreadArena *arena = NULL;
+  for (unsigned long i = 0; i < arenas.size(); i++)
+    if (!arenas[i]->claimed) {
+      arena = arenas[i];
+      break;
+    }
+
+  if (!arena) {
+    arena = new ThreadArena;
+    arenas.push_back(arena);
+  }
+
+  arena->claimed = true;
+  arena_claim.arena = arena;
+  arena_claim.lock = &lock;
+
+  return arena;
+
+} //==== FrameArena::GetThreadArena() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| FrameArena::do_allocate
+//|
+//| Purpose: This method takes memory from the blocks of the calling thread.
+//|
+//| Parameters: bytes:     the size of the memory
+//|             alignment: the alignment of the memory
+//|             returns the memory
+//|_________________________________________________________________________________
+
+void *FrameArena::do_allocate(size_t bytes, size_t alignment)
+{
+
+  ThreadArena *arena = GetThreadArena();
+
+  arena->allocations++;
+  arena->bytes += bytes;
+
+  return arena->blocks.allocate(bytes, alignment);
+
+} //==== FrameArena::do_allocate() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| FrameArena::do_deallocate
+//|
+//| Purpose: This method does nothing; memory from the arena is only released
+//|          when the next frame begins.
+//|
+//| Parameters: p:         the memory
+//|             bytes:     the size of the memory
+//|             alignment: the alignment of the memory
+//|_________________________________________________________________________________
+
+void FrameArena::do_deallocate(void * /*p*/, size_t /*bytes*/, size_t /*alignment*/)
+{
+
+} //==== FrameArena::do_deallocate() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| FrameArena::do_is_equal
+//|
+//| Purpose: This method checks whether memory from another resource can be
+//|          returned to this one.
+//|
+//| Parameters: other: the other resource
+//|             returns true if other is this
+//|_________________________________________________________________________________
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+
+  return (this == &other);
+
+} //==== FrameArena::do_is_equal() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| FrameArena::BeginFrame
+//|
+//| Purpose: This procedure releases everything made in the last frame, and
+//|          starts making new geometry from the arena.  Nothing made in the last
+//|          frame may still be in use, and no other thread may be working.
+//|
+//| Parameters: none
+//|_________________________________________________________________________________
+
+void FrameArena::BeginFrame(void)
+{
+
+  std::lock_guard<std::mutex> guard(frame_arena.lock);
+
+  for (unsigned long i = 0; i < frame_arena.arenas.size(); i++) {
+    ThreadArena *arena = frame_arena.arenas[i];
+    arena->blocks.release();
+    arena->allocations = 0;
+    arena->bytes = 0;
+  }
+
+  frame_arena.heap.allocations = 0;
+  frame_arena.in_frame = true;
+
+} //==== FrameArena::BeginFrame() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| FrameArena::EndFrame
+//|
+//| Purpose: This procedure stops making new geometry from the arena.  What was
+//|          made in the frame stays until the next frame begins.
+//|
+//| Parameters: none
+//|_________________________________________________________________________________
+
+void FrameArena::EndFrame(void)
+{
+
+  frame_arena.in_frame = false;
+
+} //==== FrameArena::EndFrame() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| FrameArena::SetEnabled
+//|
+//| Purpose: This procedure turns the arena on or off.  When it is off, frames
+//|          make their geometry from the heap, but allocations are still counted.
+//|
+//| Parameters: enabled: true to use the arena
+//|_________________________________________________________________________________
+
+void FrameArena::SetEnabled(bool enabled)
+{
+
+  frame_arena.enabled = enabled;
+
+} //==== FrameArena::SetEnabled() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| FrameArena::GetStats
+//|
+//| Purpose: This procedure counts the allocations made for geometry since the
+//|          current frame began.
+//|
+//| Parameters: stats: receives the counts
+//|_________________________________________________________________________________
+
+void FrameArena::GetStats(AllocationStats& stats)
+{
+
+  std::lock_guard<std::mutex> guard(frame_arena.lock);
+
+  stats.heap_allocations = frame_arena.heap.allocations;
+  stats.arena_allocations = 0;
+  stats.arena_bytes = 0;
+
+  for (unsigned long i = 0; i < frame_arena.arenas.size(); i++) {
+    stats.arena_allocations += frame_arena.arenas[i]->allocations;
+    stats.arena_bytes += frame_arena.arenas[i]->bytes;
+  }
+
+} //==== FrameArena::GetStats() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| FrameArena::Resource
+//|
+//| Purpose: This procedure finds where the memory for new geometry should come
+//|          from.
+//|
+//| Parameters: returns the arena during a frame, and the heap otherwise
+//|_________________________________________________________________________________
+
+std::pmr::memory_resource *FrameArena::Resource(void)
+{
+
+  if (frame_arena.in_frame && frame_arena.enabled)
+    return &frame_arena;
+
+  return &frame_arena.heap;
+
+} //==== FrameArena::Resource() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| FrameArena::AllocateObject
+//|
+//| Purpose: This procedure allocates memory for a Solid or Vector, from the
+//|          arena during a frame and from the heap otherwise.
+//|
+//| Parameters: size: the size of the object
+//|             returns the memory for the object
+//|_________________________________________________________________________________
+
+void *FrameArena::AllocateObject(size_t size)
+{
+
+  std::pmr::memory_resource *resource = Resource();
+
+  ObjectHeader *header = (ObjectHeader *) resource->allocate(sizeof(ObjectHeader) + size,
+							     alignof(ObjectHeader));
+  header->resource = resource;
+  header->size = size;
+
+  return header + 1;
+
+} //==== FrameArena::AllocateObject() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| FrameArena::FreeObject
+//|
+//| Purpose: This procedure frees memory allocated by AllocateObject, giving it
+//|          back wherever it came from.
+//|
+//| Parameters: object: the memory for the object, or NULL
+//|_________________________________________________________________________________
+
+void FrameArena::FreeObject(void *object)
+{
+
+  if (!object)
+    return;
+
+  ObjectHeader *header = ((ObjectHeader *) object) - 1;
+  header->resource->deallocate(header, sizeof(ObjectHeader) + header->size, alignof(ObjectHeader));
+
+} //==== FrameArena::FreeObject() ====//
@@ -0,0 +1,118 @@
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Arena.h
+//|
+//| This is the interface to the frame arena.  While a frame is being prepared,
+//| the Solids, Faces and corners made for it, and the lists inside them, get
+//| their memory by bumping a pointer through large blocks instead of from the
+//| heap.  Nothing made in the frame is freed one piece at a time; all of it is
+//| released at once when the next frame begins.  Each thread bumps through its
+//| own blocks, so the threads of the ThreadPool don't contend for them.
+//|_____________________________________________________________________________
+
+#ifndef HARENA
+#define HARENA
+
+
+#include <atomic>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+#include <stddef.h>
+
+
+class ArenaClaim;
+class Face;
+class Vector;
+
+
+//  The size of the blocks the arena bumps through
+#define ARENA_BLOCK_SIZE	(1024*1024)
+
+
+//
+//  The lists of Faces and corners kept by Solids and Faces.  They get their memory
+//  from the arena if it was in use when they were made, and from the heap if not.
+//
+
+typedef std::pmr::vector<Face *> FaceList;
+typedef std::pmr::vector<Vector *> CornerList;
+
+
+//
+//  Counts of the allocations made for geometry since the last frame began.
+//
+
+class AllocationStats
+{
+
+public:
+
+  unsigned long heap_allocations;
+  unsigned long arena_allocations;
+  unsigned long arena_bytes;
+
+};
+
+
+class FrameArena : public std::pmr::memory_resource
+{
+
+  friend class ArenaClaim;
+
+  //  The blocks of one thread, and what it has taken from them this frame
+  class ThreadArena
+  {
+  public:
+    std::pmr::monotonic_buffer_resource blocks;
+    unsigned long allocations;
+    unsigned long bytes;
+    bool claimed;
+    ThreadArena(void);
+  };
+
+  //  Passes allocations on to the heap, counting them
+  class HeapResource : public std::pmr::memory_resource
+  {
+  public:
+    std::atomic<unsigned long> allocations;
+    HeapResource(void);
+  private:
+    void *do_allocate(size_t bytes, size_t alignment);
+    void do_deallocate(void *p, size_t bytes, size_t alignment);
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept;
+  };
+
+  //  The arenas of all threads which have used the arena; guarded by lock
+  std::mutex lock;
+  std::vector<ThreadArena *> arenas;
+
+  HeapResource heap;
+
+  //  true if new geometry comes from the arena
+  bool in_frame;
+  bool enabled;
+
+  ThreadArena *GetThreadArena(void);
+
+  void *do_allocate(size_t bytes, size_t alignment);
+  void do_deallocate(void *p, size_t bytes, size_t alignment);
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept;
+
+  static FrameArena frame_arena;
+
+  FrameArena(void);
+
+public:
+
+  static void BeginFrame(void);
+  static void EndFrame(void);
+  static void SetEnabled(bool enabled);
+  static void GetStats(AllocationStats& stats);
+
+  static std::pmr::memory_resource *Resource(void);
+  static void *AllocateObject(size_t size);
+  static void FreeObject(void *object);
+
+};
+
+#endif
@@ -5,6 +5,9 @@
 #include "face.h"
 #include "debug.h"
 #include "state.h"
+#include "enumerator.h"
+#include "threadpool.h"
+#include "arena.h"
 
 
 //====  PROTOTYPES
@@ -41,6 +44,11 @@ void initState(State &state) {
   state.rotate4D = false;
   state.demoInitialized = false;
   state.drawcubeFlag = false;
+  state.vertexEnumerator = DOUBLE_DESCRIPTION_ENUMERATOR;
+  state.numThreads = 0;
+  state.useArena = true;
+  state.printStats = false;
+  state.fragmentBudget = 1;
   
   state.theta = 0;
   state.rho = 0;
@@ -95,6 +103,24 @@ void prepareDemoFrame(State &state) {
   if (!state.demoInitialized)
     initDemo(state);
 
+  // The demo space lasts longer than a frame, so find its adjacencies before
+  // the frame starts making geometry from the arena
+  if (state.demoSpace)
+    state.demoSpace->EnsureAdjacencies();
+
+  // Release everything made for the last frame; it was all deleted above
+  FrameArena::SetEnabled(state.useArena);
+  FrameArena::BeginFrame();
+
+  // Use the selected engine and number of threads to find corners
+  Solid::SetVertexEnumerator(state.vertexEnumerator);
+  ThreadPool::SetNumThreads(state.numThreads);
+
+  // Merge the pieces hidden solid removal leaves as far as asked, and count them
+  Space::SetFragmentBudget(state.fragmentBudget);
+  Space::ClearHiddenRemovalStats();
+  Solid::ClearOrderStats();
+
   Space *workingSpace = state.demoSpace;
 
   if (workingSpace && (state.dimension >= 4) && (workingSpace->Dimension() == 4))
@@ -136,6 +162,28 @@ void prepareDemoFrame(State &state) {
   if (state.draw1DSpace)
     state.draw1DSpace->EnsureAdjacencies();
 
+  FrameArena::EndFrame();
+
+  if (state.printStats) {
+    AllocationStats stats;
+    FrameArena::GetStats(stats);
+    std::cout << "Frame allocations: " << stats.heap_allocations << " from the heap, "
+	      << stats.arena_allocations << " from the arena (" << stats.arena_bytes << " bytes)"
+	      << std::endl;
+
+    HiddenRemovalStats removal_stats;
+    Space::GetHiddenRemovalStats(removal_stats);
+    std::cout << "Hidden solid removal: " << removal_stats.fragments_made << " pieces, "
+	      << removal_stats.fragments_kept << " after merging; " << removal_stats.pairs_ordered
+	      << " pairs ordered, " << removal_stats.pairs_culled << " culled" << std::endl;
+
+    OrderStats order_stats;
+    Solid::GetOrderStats(order_stats);
+    std::cout << "Ordering: " << order_stats.box_separated << " by boxes, " << order_stats.face_separated
+	      << " by silhouette faces, " << order_stats.depth_ordered << " by depth, "
+	      << order_stats.corner_tested << " by corners" << std::endl;
+  }
+
 }  //==== prepareDemoFrame() ====//
 
 
@@ -0,0 +1,865 @@
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Enumerator.cp
+//|
+//| This is the implementation of the VertexEnumerator classes.  A
+//| VertexEnumerator finds the corners of a Solid.
+//|_____________________________________________________________________________
+
+#include "enumerator.h"
+#include "face.h"
+#include "kernels.h"
+#include "solid.h"
+#include "vector.h"
+#include "threadpool.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+
+//  Solids with at least this many combinations of Faces have their corners found on
+//  the thread pool by CombinationEnumerator.
+#define PARALLEL_COMBINATIONS	2000
+
+//  Pivots smaller than this are considered zero when finding the rank of a set
+//  of (normalized) face normals.
+#define RANK_EPSILON		1E-10
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| VertexEnumerator::~VertexEnumerator
+//|
+//| Purpose: This method disposes of a VertexEnumerator.
+//|
+//| Parameters: none
+//|_________________________________________________________________________________
+
+VertexEnumerator::~VertexEnumerator(void)
+{
+
+} //==== VertexEnumerator::~VertexEnumerator() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| VertexEnumerator::GetVertexEnumerator
+//|
+//| Purpose: This procedure returns the enumerator for one of the enumeration
+//|          engines.
+//|
+//| Parameters: which: DOUBLE_DESCRIPTION_ENUMERATOR or COMBINATION_ENUMERATOR
+//|             returns the enumerator
+//|_________________________________________________________________________________
+
+VertexEnumerator *VertexEnumerator::GetVertexEnumerator(int which)
+{
+
+  static DoubleDescriptionEnumerator double_description;
+  static CombinationEnumerator combinations;
+
+  if (which == COMBINATION_ENUMERATOR)
+    return &combinations;
+
+  return &double_description;
+
+} //==== VertexEnumerator::GetVertexEnumerator() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| VertexEnumerator::LookupVertexEnumerator
+//|
+//| Purpose: This procedure finds an enumeration engine by name.
+//|
+//| Parameters: name: "doubledescription" or "combinations"
+//|             returns the engine, or -1 if the name is not known
+//|_________________________________________________________________________________
+
+int VertexEnumerator::LookupVertexEnumerator(const char *name)
+{
+
+  if (!strcasecmp(name, "doubledescription") || !strcasecmp(name, "dd"))
+    return DOUBLE_DESCRIPTION_ENUMERATOR;
+
+  if (!strcasecmp(name, "combinations"))
+    return COMBINATION_ENUMERATOR;
+
+  return -1;
+
+} //==== VertexEnumerator::LookupVertexEnumerator() ====//
+
+
+
+//
+//  The combinations of Faces being intersected by CombinationEnumerator, as a
+//  stack.  Entry d holds the Face chosen at depth d, and that Face's equation
+//  after it has been reduced by the equations above it:  it is zero in the
+//  pivot column of every equation above it, and its own pivot column is the one
+//  where it is largest.  Each deeper combination only has to reduce one more
+//  equation.  The corners found are collected, with the indices of the Faces
+//  through each (highest index first), until they are added to the Solid.
+//
+
+class CombinationStack
+{
+
+public:
+
+  const DimensionKernels *kernels;
+
+  std::vector<unsigned long> chosen;
+  std::vector<double> rows;
+  std::vector<long> pivot_columns;
+
+  std::vector<Vector *> corners;
+  std::vector<unsigned long> corner_faces;
+
+};
+
+
+//
+//  The work of finding the corners of one Solid, split into chunks by the first
+//  Face of each combination, so the chunks can be done on different threads.
+//
+
+class CombinationJob
+{
+
+public:
+
+  Solid *solid;
+  std::vector<CombinationStack> chunks;
+
+};
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Procedure PushEquation
+//|
+//| Purpose: This procedure reduces the equation of a Face by the equations
+//|          already on the stack, and puts it on the stack.
+//|
+//| Parameters: stack:     the stack
+//|             depth:     the number of equations already on the stack
+//|             face:      the Face
+//|             index:     the index of face in the Solid
+//|             dimension: the dimension of the space
+//|             returns false if the Face is dependent on the Faces on the stack,
+//|             so no combination containing them all meets in a point
+//|_________________________________________________________________________________
+
+static bool PushEquation(CombinationStack& stack, long depth, const Face *face, unsigned long index,
+			 long dimension)
+{
+
+  double *row = &stack.rows[depth*(dimension+1)];
+  long e, k;
+
+  memmove(row, face->coordinates, (dimension+1) * sizeof(double));
+
+  //  Eliminate the pivot column of each equation above this one
+  for (e = 0; e < depth; e++) {
+    const double *above = &stack.rows[e*(dimension+1)];
+    long pivot_column = stack.pivot_columns[e];
+    double factor = row[pivot_column] / above[pivot_column];
+    stack.kernels->eliminate(dimension, row, above, factor);
+    row[pivot_column] = 0.0;
+  }
+
+  //  Use the largest remaining coefficient as the pivot
+  long pivot_column = 0;
+  for (k = 1; k < dimension; k++)
+    if (fabs(row[k]) > fabs(row[pivot_column]))
+      pivot_column = k;
+
+  //  Nothing is left; this Face is dependent on the ones above it
+  if (fabs(row[pivot_column]) < VERY_SMALL_NUM)
+    return false;
+
+  stack.pivot_columns[depth] = pivot_column;
+  stack.chosen[depth] = index;
+
+  return true;
+
+} //==== PushEquation() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Procedure IntersectCombinations
+//|
+//| Purpose: This procedure extends the combination on the stack with each Face
+//|          from first to last in turn.  Complete combinations are intersected,
+//|          and the intersections which are inside the Solid are collected on the
+//|          stack.
+//|
+//| Parameters: solid:     the Solid
+//|             dimension: the dimension of the space
+//|             stack:     the combination so far
+//|             depth:     the number of Faces chosen so far
+//|             first:     the first Face which may be chosen next
+//|             last:      the last Face which may be chosen next
+//|_________________________________________________________________________________
+
+static void IntersectCombinations(const Solid& solid, long dimension, CombinationStack& stack,
+				  long depth, unsigned long first, unsigned long last)
+{
+
+  const FaceList &faces = solid.Faces();
+  long e, k;
+
+  for (unsigned long index = first; index <= last; index++) {
+
+    //  A Face dependent on the ones chosen so far can't be in any combination with them
+    if (!PushEquation(stack, depth, faces[index], index, dimension))
+      continue;
+
+    //  Leave enough Faces for the rest of the combination
+    if (depth < dimension-1) {
+      IntersectCombinations(solid, dimension, stack, depth+1, index+1, faces.size() - (dimension - depth - 1));
+      continue;
+    }
+
+    //
+    //  The combination is complete.  The last equation has only its pivot left, and each
+    //  equation above it has only its own pivot and those of the equations below it, so
+    //  the variables can be found from the bottom up.
+    //
+
+    Vector *point = new Vector(dimension);
+    for (e = dimension-1; e >= 0; e--) {
+      const double *row = &stack.rows[e*(dimension+1)];
+      double sum = row[dimension];
+      for (k = e+1; k < dimension; k++)
+	sum += row[stack.pivot_columns[k]] * point->coordinates[stack.pivot_columns[k]];
+      point->coordinates[stack.pivot_columns[e]] = -sum / row[stack.pivot_columns[e]];
+    }
+
+    //  If this point is not inside all the Faces, it is not a corner
+    if (!solid.PointInsideOrOn(*point)) {
+      delete(point);
+      continue;
+    }
+
+    stack.corners.push_back(point);
+    for (e = dimension-1; e >= 0; e--)
+      stack.corner_faces.push_back(stack.chosen[e]);
+
+  }
+
+} //==== IntersectCombinations() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Procedure FindChunkCorners
+//|
+//| Purpose: This procedure finds the corners made by the combinations whose first
+//|          Face is the given one.  It doesn't change the Solid, so chunks can
+//|          be done on different threads at once.
+//|
+//| Parameters: chunk: the index of the first Face
+//|             data:  the CombinationJob
+//|_________________________________________________________________________________
+
+static void FindChunkCorners(long chunk, void *data)
+{
+
+  CombinationJob *job = (CombinationJob *) data;
+  long dimension = job->solid->Dimension();
+
+  CombinationStack &stack = job->chunks[chunk];
+  stack.kernels = job->solid->Kernels();
+  stack.chosen.resize(dimension);
+  stack.rows.resize(dimension * (dimension+1));
+  stack.pivot_columns.resize(dimension);
+
+  IntersectCombinations(*job->solid, dimension, stack, 0, chunk, chunk);
+
+} //==== FindChunkCorners() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| CombinationEnumerator::FindCorners
+//|
+//| Purpose: This method finds all the corners of solid by intersecting every
+//|          combination of dimension Faces, and passing each intersection to
+//|          Solid::ProcessCorner.
+//|
+//| Parameters: solid: the Solid whose corners to find
+//|             returns false, since this doesn't tell whether solid is bounded
+//|_________________________________________________________________________________
+
+bool CombinationEnumerator::FindCorners(Solid& solid)
+{
+
+  const FaceList &faces = solid.Faces();
+  unsigned long dimension = solid.Dimension();
+  unsigned long i;
+  long chunk;
+
+  //  Fewer faces than dimensions can't meet in a point
+  if ((dimension == 0) || (faces.size() < dimension))
+    return false;
+
+  //
+  //  The combinations are visited in increasing order, one Face at a time, so combinations
+  //  which start with the same Faces share the work of eliminating them.  If the Faces
+  //  chosen so far are dependent, every combination which starts with them is skipped.
+  //
+  //  The combinations are split into chunks by their first Face.  If there are enough
+  //  combinations, the chunks are done on the thread pool; either way, the corners are added
+  //  to the Solid chunk by chunk afterwards, so they come out in the same order.
+  //
+
+  CombinationJob job;
+  job.solid = &solid;
+  long num_chunks = faces.size() - dimension + 1;
+  job.chunks.resize(num_chunks);
+
+  double num_combinations = 1;
+  for (i = 0; i < dimension; i++)
+    num_combinations = num_combinations * (faces.size() - i) / (i + 1);
+
+  if (num_combinations >= PARALLEL_COMBINATIONS)
+    ThreadPool::GetThreadPool()->Run(num_chunks, FindChunkCorners, &job);
+  else
+    for (chunk = 0; chunk < num_chunks; chunk++)
+      FindChunkCorners(chunk, &job);
+
+  //  Add the corners to the Solid
+  std::vector<Face *> intersected_faces;
+  for (chunk = 0; chunk < num_chunks; chunk++) {
+
+    CombinationStack &stack = job.chunks[chunk];
+    for (i = 0; i < stack.corners.size(); i++) {
+
+      intersected_faces.erase(intersected_faces.begin(), intersected_faces.end());
+      for (unsigned long j = 0; j < dimension; j++)
+	intersected_faces.push_back(faces[stack.corner_faces[i*dimension + j]]);
+
+      solid.AddCorner(stack.corners[i], intersected_faces);
+
+    }
+
+  }
+
+  return false;
+
+} //==== CombinationEnumerator::FindCorners() ====//
+
+
+
+//
+//  A corner of the partial Solid built by the double description, with the
+//  indices of the constraints whose boundaries pass through it, in increasing
+//  order.
+//
+
+class DDCorner
+{
+
+public:
+
+  std::vector<double> coordinates;
+  std::vector<long> tight;
+
+};
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Procedure NormalsRank
+//|
+//| Purpose: This procedure finds whether the normals of a set of constraints span
+//|          at least rank dimensions.
+//|
+//| Parameters: constraints: the constraint matrix, one row of dimension+1 terms
+//|                          per constraint, normals of unit length
+//|             which:       indices of the rows to consider
+//|             dimension:   the dimension of the space
+//|             rank:        the rank to look for
+//|             returns true if the normals have at least rank rank
+//|_________________________________________________________________________________
+
+static bool NormalsRank(const std::vector<double>& constraints, const std::vector<long>& which,
+			long dimension, long rank)
+{
+
+  long num_rows = which.size();
+  if (num_rows < rank)
+    return false;
+
+  //  Copy the normals so we can eliminate in place
+  std::vector<double> m(num_rows * dimension);
+  long i, j, k;
+  for (i = 0; i < num_rows; i++)
+    memmove(&m[i*dimension], &constraints[which[i]*(dimension+1)], dimension * sizeof(double));
+
+  //  Gaussian elimination with partial pivoting, one column at a time
+  long found = 0;
+  for (j = 0; (j < dimension) && (found < num_rows); j++) {
+
+    //  Find the largest pivot in this column
+    long max = found;
+    for (i = found+1; i < num_rows; i++)
+      if (fabs(m[i*dimension + j]) > fabs(m[max*dimension + j]))
+	max = i;
+
+    //  No pivot in this column
+    if (fabs(m[max*dimension + j]) < RANK_EPSILON)
+      continue;
+
+    //  Swap the pivot row into place
+    for (k = j; k < dimension; k++)
+      std::swap(m[max*dimension + k], m[found*dimension + k]);
+
+    //  Eliminate this column from the rows below
+    for (i = found+1; i < num_rows; i++) {
+      double factor = m[i*dimension + j] / m[found*dimension + j];
+      for (k = j; k < dimension; k++)
+	m[i*dimension + k] -= factor * m[found*dimension + k];
+    }
+
+    if (++found >= rank)
+      return true;
+
+  }
+
+  return (found >= rank);
+
+} //==== NormalsRank() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Procedure CornersAdjacent
+//|
+//| Purpose: This procedure checks whether two corners are joined by an edge.  They
+//|          are if the constraints through both of them meet in a line, that is,
+//|          if their normals have rank dimension-1.
+//|
+//| Parameters: corner1, corner2: the corners
+//|             constraints:      the constraint matrix
+//|             dimension:        the dimension of the space
+//|             returns true if the corners are joined by an edge
+//|_________________________________________________________________________________
+
+static bool CornersAdjacent(const DDCorner& corner1, const DDCorner& corner2,
+			    const std::vector<double>& constraints, long dimension)
+{
+
+  //  Find the constraints through both corners
+  std::vector<long> common;
+  std::set_intersection(corner1.tight.begin(), corner1.tight.end(),
+			corner2.tight.begin(), corner2.tight.end(),
+			std::back_inserter(common));
+
+  return NormalsRank(constraints, common, dimension, dimension-1);
+
+} //==== CornersAdjacent() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Procedure CutCorners
+//|
+//| Purpose: This procedure is one step of the double description.  It cuts the
+//|          partial Solid described by corners with one more constraint: corners
+//|          outside the constraint are removed, and a new corner is added wherever
+//|          an edge crosses the constraint's boundary.
+//|
+//| Parameters: corners:     the corners of the partial Solid; receives the corners
+//|                          of the cut Solid
+//|             constraints: the constraint matrix
+//|             index:       the index of the constraint to cut with
+//|             dimension:   the dimension of the space
+//|             kernels:     the kernels for the dimension
+//|_________________________________________________________________________________
+
+static void CutCorners(std::vector<DDCorner>& corners, const std::vector<double>& constraints,
+		       long index, long dimension, const DimensionKernels *kernels)
+{
+
+  const double *row = &constraints[index*(dimension+1)];
+
+  //  Evaluate the constraint at every corner
+  std::vector<double> values(corners.size());
+  bool any_outside = false;
+  unsigned long i;
+  for (i = 0; i < corners.size(); i++) {
+    double value = kernels->evaluate(dimension, row, &corners[i].coordinates[0]);
+    values[i] = value;
+    if (value < -VERY_SMALL_NUM)
+      any_outside = true;
+  }
+
+  //  Find the new corners where edges from inside corners to outside corners cross the boundary
+  std::vector<DDCorner> cut_corners;
+  if (any_outside) {
+    for (i = 0; i < corners.size(); i++) {
+      if (values[i] <= VERY_SMALL_NUM)
+	continue;
+      unsigned long j;
+      for (j = 0; j < corners.size(); j++) {
+	if (values[j] >= -VERY_SMALL_NUM)
+	  continue;
+	if (!CornersAdjacent(corners[i], corners[j], constraints, dimension))
+	  continue;
+
+	//  The crossing is the fraction t of the way from the inside corner to the outside one
+	DDCorner corner;
+	double t = values[i] / (values[i] - values[j]);
+	corner.coordinates.resize(dimension);
+	kernels->interpolate(dimension, &corner.coordinates[0], &corners[i].coordinates[0],
+			     &corners[j].coordinates[0], t);
+
+	//  It lies on the constraints common to both, and on the new one
+	std::set_intersection(corners[i].tight.begin(), corners[i].tight.end(),
+			      corners[j].tight.begin(), corners[j].tight.end(),
+			      std::back_inserter(corner.tight));
+	corner.tight.insert(std::lower_bound(corner.tight.begin(), corner.tight.end(), index), index);
+
+	cut_corners.push_back(corner);
+      }
+    }
+  }
+
+  //  Keep the corners inside or on the constraint; those on it now touch it too
+  for (i = 0; i < corners.size(); i++) {
+    if (values[i] < -VERY_SMALL_NUM)
+      continue;
+    if (values[i] <= VERY_SMALL_NUM)
+      corners[i].tight.insert(std::lower_bound(corners[i].tight.begin(), corners[i].tight.end(), index),
+			      index);
+    cut_corners.push_back(corners[i]);
+  }
+
+  corners.swap(cut_corners);
+
+} //==== CutCorners() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Procedure DuplicateConstraint
+//|
+//| Purpose: This procedure checks whether a constraint is the same as an earlier
+//|          usable one.  A second copy of a Face would touch every corner of the
+//|          first and look adjacent to it, so only the first copy is cut with;
+//|          the second touches nothing and gets removed as redundant.
+//|
+//| Parameters: constraints: the constraint matrix
+//|             usable:      which of the earlier constraints are used
+//|             index:       the constraint to check
+//|             dimension:   the dimension of the space
+//|             returns true if the constraint is a duplicate
+//|_________________________________________________________________________________
+
+static bool DuplicateConstraint(const std::vector<double>& constraints, const std::vector<bool>& usable,
+				long index, long dimension)
+{
+
+  const double *row = &constraints[index*(dimension+1)];
+
+  for (long j = 0; j < index; j++) {
+
+    if (!usable[j])
+      continue;
+
+    const double *other = &constraints[j*(dimension+1)];
+    long k;
+    for (k = 0; k <= dimension; k++)
+      if (fabs(row[k] - other[k]) > VERY_SMALL_NUM)
+	break;
+    if (k > dimension)
+      return true;
+
+  }
+
+  return false;
+
+} //==== DuplicateConstraint() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Procedure NormalizeConstraints
+//|
+//| Purpose: This procedure copies the Faces into the first rows of the constraint
+//|          matrix, scaling each row so its normal has unit length, so the
+//|          tolerances used with the matrix are distances.
+//|
+//| Parameters: faces:       the Faces
+//|             dimension:   the dimension of the space
+//|             constraints: receives the rows; must have room for them
+//|             usable:      receives which rows should be cut with
+//|             returns false if some Face is nowhere, so the Solid is empty
+//|_________________________________________________________________________________
+
+static bool NormalizeConstraints(const FaceList& faces, long dimension,
+				 std::vector<double>& constraints, std::vector<bool>& usable)
+{
+
+  long num_faces = faces.size();
+  long i, k;
+
+  usable.resize(num_faces);
+  for (i = 0; i < num_faces; i++) {
+
+    double *row = &constraints[i*(dimension+1)];
+    memmove(row, faces[i]->coordinates, (dimension+1) * sizeof(double));
+
+    double length = 0;
+    for (k = 0; k < dimension; k++)
+      length += row[k]*row[k];
+    length = sqrt(length);
+
+    //  A face with no normal is either everywhere or nowhere
+    usable[i] = (length > VERY_SMALL_NUM);
+    if (!usable[i]) {
+      if (row[dimension] < -VERY_SMALL_NUM)
+	return false;
+      continue;
+    }
+
+    for (k = 0; k <= dimension; k++)
+      row[k] /= length;
+
+    if (DuplicateConstraint(constraints, usable, i, dimension))
+      usable[i] = false;
+
+  }
+
+  return true;
+
+} //==== NormalizeConstraints() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Procedure ReportCorners
+//|
+//| Purpose: This procedure passes the corners which touch only Faces to
+//|          Solid::ProcessCorner, along with the Faces which pass through them.
+//|
+//| Parameters: corners:   the corners
+//|             solid:     the Solid to report them to
+//|             num_faces: the number of rows of the constraint matrix which are
+//|                        Faces of solid; rows after these are not
+//|_________________________________________________________________________________
+
+static void ReportCorners(std::vector<DDCorner>& corners, Solid& solid, long num_faces)
+{
+
+  const FaceList &faces = solid.Faces();
+  long dimension = solid.Dimension();
+
+  std::vector<Face *> contributing_faces;
+  for (std::vector<DDCorner>::iterator corner = corners.begin(); corner != corners.end(); corner++) {
+
+    //  Constraint indices are in increasing order, so another constraint would be last
+    if (corner->tight.empty() || (corner->tight.back() >= num_faces))
+      continue;
+
+    Vector *point = new Vector(dimension);
+    memmove(point->coordinates, &corner->coordinates[0], dimension * sizeof(double));
+
+    contributing_faces.erase(contributing_faces.begin(), contributing_faces.end());
+    for (std::vector<long>::iterator index = corner->tight.begin(); index != corner->tight.end(); index++)
+      contributing_faces.push_back(faces[*index]);
+
+    solid.ProcessCorner(point, contributing_faces);
+
+  }
+
+} //==== ReportCorners() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| DoubleDescriptionEnumerator::FindCorners
+//|
+//| Purpose: This method finds all the corners of solid with the double
+//|          description method, and passes each one to Solid::ProcessCorner along
+//|          with all the Faces which pass through it.
+//|
+//| Parameters: solid: the Solid whose corners to find
+//|             returns true if solid is bounded
+//|_________________________________________________________________________________
+
+bool DoubleDescriptionEnumerator::FindCorners(Solid& solid)
+{
+
+  //
+  //  We start with a box much larger than any Solid, whose corners are easy to write
+  //  down, and cut it with each Face of the Solid in turn.  Each cut keeps the corners
+  //  inside the Face, and adds a corner wherever an edge of the partial Solid crosses
+  //  the Face; two corners are joined by an edge if the constraints through both of
+  //  them meet in a line.  When all Faces have been applied, the corners which don't
+  //  touch the box are the corners of the Solid.
+  //
+  //  The constraints are kept in a matrix with one row per Face followed by two rows
+  //  per axis for the box.  Each row is scaled so its normal has unit length, so the
+  //  tolerances below are distances.
+  //
+
+  const FaceList &faces = solid.Faces();
+  long dimension = solid.Dimension();
+  long num_faces = faces.size();
+  long num_constraints = num_faces + 2*dimension;
+  long i, k;
+
+  //  Build the constraint matrix; if some Face is nowhere, the Solid is empty
+  std::vector<double> constraints(num_constraints * (dimension+1));
+  std::vector<bool> usable;
+  if (!NormalizeConstraints(faces, dimension, constraints, usable))
+    return true;
+
+  //  Add the box:  xk + size > 0  and  -xk + size > 0
+  for (k = 0; k < dimension; k++) {
+    double *lower = &constraints[(num_faces + 2*k)*(dimension+1)];
+    double *upper = lower + (dimension+1);
+    lower[k] = 1;
+    lower[dimension] = BOUNDING_BOX_SIZE;
+    upper[k] = -1;
+    upper[dimension] = BOUNDING_BOX_SIZE;
+  }
+
+  //  The corners of the box are all the combinations of the lower and upper bounds
+  std::vector<DDCorner> corners(1L << dimension);
+  for (i = 0; i < (1L << dimension); i++) {
+    corners[i].coordinates.resize(dimension);
+    for (k = 0; k < dimension; k++) {
+      bool upper = (i >> k) & 1;
+      corners[i].coordinates[k] = upper ? BOUNDING_BOX_SIZE : -BOUNDING_BOX_SIZE;
+      corners[i].tight.push_back(num_faces + 2*k + (upper ? 1 : 0));
+    }
+  }
+
+  //  Cut the box with each Face in turn
+  for (i = 0; (i < num_faces) && !corners.empty(); i++)
+    if (usable[i])
+      CutCorners(corners, constraints, i, dimension, solid.Kernels());
+
+  //  If any corner still touches the box, the Solid is unbounded
+  bool bounded = true;
+  for (std::vector<DDCorner>::iterator corner = corners.begin(); corner != corners.end(); corner++)
+    if (corner->tight.empty() || (corner->tight.back() >= num_faces))
+      bounded = false;
+
+  //  Report the corners which don't touch the box
+  ReportCorners(corners, solid, num_faces);
+
+  return bounded;
+
+} //==== DoubleDescriptionEnumerator::FindCorners() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| DoubleDescriptionEnumerator::SliceCorners
+//|
+//| Purpose: This method finds the corners of the two halves of a sliced Solid
+//|          by cutting the corners of the original Solid with the slicing
+//|          hyperplane, and passes them to Solid::ProcessCorner for each half.
+//|          Only edges of the original which cross the hyperplane make new
+//|          corners, so the halves don't need to be enumerated from scratch.
+//|
+//| Parameters: solid_corners: the corners of the Solid which was sliced; they
+//|                            must be valid, and it must be bounded
+//|             inside_solid:  the half inside the hyperplane: the Faces of the
+//|                            sliced Solid, followed by the slicing halfspace.
+//|                            This may be the sliced Solid itself.
+//|             outside_solid: the half outside the hyperplane: the Faces of the
+//|                            sliced Solid, followed by the flipped halfspace
+//|             returns false if the halves could not be found this way, in
+//|             which case nothing has been passed to either of them
+//|_________________________________________________________________________________
+
+bool DoubleDescriptionEnumerator::SliceCorners(const CornerList& solid_corners, Solid& inside_solid, Solid& outside_solid)
+{
+
+  const FaceList &faces = inside_solid.Faces();
+  long dimension = inside_solid.Dimension();
+  long num_faces = faces.size();
+  long slice = num_faces - 1;
+  long i, k;
+
+  ASSERT(outside_solid.Faces().size() == faces.size());
+
+  //  Build the constraint matrix; the last row is the slicing halfspace
+  std::vector<double> constraints(num_faces * (dimension+1));
+  std::vector<bool> usable;
+  if (!NormalizeConstraints(faces, dimension, constraints, usable))
+    return false;
+
+  //  A slicing halfspace with no normal doesn't cut anything
+  double length = 0;
+  for (k = 0; k < dimension; k++)
+    length += faces[slice]->coordinates[k] * faces[slice]->coordinates[k];
+  if (sqrt(length) <= VERY_SMALL_NUM)
+    return false;
+
+  //  Find which Faces of the sliced Solid pass through each of its corners.  Corners
+  //  which are really the same are merged.
+  std::vector<DDCorner> corners;
+  for (CornerList::const_iterator solid_corner = solid_corners.begin();
+       solid_corner != solid_corners.end(); solid_corner++) {
+
+    DDCorner corner;
+    corner.coordinates.assign((*solid_corner)->coordinates, (*solid_corner)->coordinates + dimension);
+    for (i = 0; i < slice; i++) {
+      if (!usable[i])
+	continue;
+      const double *row = &constraints[i*(dimension+1)];
+      double value = row[dimension];
+      for (k = 0; k < dimension; k++)
+	value += row[k] * corner.coordinates[k];
+      if (fabs(value) <= VERY_SMALL_NUM)
+	corner.tight.push_back(i);
+    }
+
+    std::vector<DDCorner>::iterator same;
+    for (same = corners.begin(); same != corners.end(); same++) {
+      for (k = 0; k < dimension; k++)
+	if (fabs(same->coordinates[k] - corner.coordinates[k]) > VERY_SMALL_NUM)
+	  break;
+      if (k == dimension)
+	break;
+    }
+
+    if (same == corners.end())
+      corners.push_back(corner);
+    else {
+      std::vector<long> tight;
+      std::set_union(same->tight.begin(), same->tight.end(), corner.tight.begin(), corner.tight.end(),
+		     std::back_inserter(tight));
+      same->tight.swap(tight);
+    }
+
+  }
+
+  //  Cut a copy of the corners with the slicing halfspace for the inside half...
+  std::vector<DDCorner> outside_corners(corners);
+  if (usable[slice])
+    CutCorners(corners, constraints, slice, dimension, inside_solid.Kernels());
+
+  //  ...and with the flipped halfspace for the outside half
+  double *row = &constraints[slice*(dimension+1)];
+  for (k = 0; k <= dimension; k++)
+    row[k] = -row[k];
+  usable[slice] = !DuplicateConstraint(constraints, usable, slice, dimension);
+  if (usable[slice])
+    CutCorners(outside_corners, constraints, slice, dimension, inside_solid.Kernels());
+
+  ReportCorners(corners, inside_solid, num_faces);
+  ReportCorners(outside_corners, outside_solid, num_faces);
+
+  return true;
+
+} //==== DoubleDescriptionEnumerator::SliceCorners() ====//
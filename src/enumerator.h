@@ -0,0 +1,75 @@
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Enumerator.h
+//|
+//| This is the interface to the VertexEnumerator classes.  A VertexEnumerator
+//| finds the corners of a Solid, and reports each one to Solid::ProcessCorner
+//| along with the Faces which meet there.  Solid::FindAdjacencies uses
+//| whichever enumerator has been selected with Solid::SetVertexEnumerator.
+//| FindCorners returns true if the corners it found describe the Solid
+//| completely, that is, if the Solid is known to be bounded.
+//|_____________________________________________________________________________
+
+#ifndef HENUMERATOR
+#define HENUMERATOR
+
+
+#include "adsoda_types.h"
+#include "arena.h"
+
+class Solid;
+
+
+//  The available vertex enumeration engines
+enum
+	{
+	DOUBLE_DESCRIPTION_ENUMERATOR,
+	COMBINATION_ENUMERATOR
+	};
+
+
+class VertexEnumerator
+{
+
+public:
+
+  virtual ~VertexEnumerator(void);
+
+  virtual bool FindCorners(Solid& solid) = 0;
+
+  static VertexEnumerator *GetVertexEnumerator(int which);
+  static int LookupVertexEnumerator(const char *name);
+
+};
+
+
+//  Intersects every combination of dimension Faces, and keeps the intersections
+//  which lie inside the Solid.  Combinations which start with the same Faces share
+//  their elimination, and those which start with dependent Faces are skipped, but
+//  the cost still grows with C(F, n) no matter how many corners the Solid has.
+class CombinationEnumerator : public VertexEnumerator
+{
+
+public:
+
+  virtual bool FindCorners(Solid& solid);
+
+};
+
+
+//  Builds the corners incrementally, one Face at a time, by cutting the corner
+//  graph of the Faces seen so far with the next Face.  The cost depends on the
+//  number of corners of the intermediate Solids rather than on C(F, n).  The
+//  same cut is used by SliceCorners to find the corners of the two halves of a
+//  sliced Solid from the corners of the original.
+class DoubleDescriptionEnumerator : public VertexEnumerator
+{
+
+public:
+
+  virtual bool FindCorners(Solid& solid);
+
+  static bool SliceCorners(const CornerList& solid_corners, Solid& inside_solid, Solid& outside_solid);
+
+};
+
+#endif
@@ -22,10 +22,18 @@
 Face::Face(long dim) :
 
   // Construct as a Halfspace
-  Halfspace(dim)
+  Halfspace(dim),
+
+  // Make the lists where the rest of the frame's geometry is made
+  touching_corners(FrameArena::Resource()),
+  adjacent_faces(FrameArena::Resource()),
+  corner_set(FrameArena::Resource()),
+  adjacent_set(FrameArena::Resource())
 
 {
 
+  index = -1;
+
 }	//==== Face::Face() ====//
 
 
@@ -41,13 +49,21 @@ Face::Face(long dim) :
 Face::Face(Face &face) :
 
   // Create halfspace of correct dimension
-  Halfspace(face.Dimension())
+  Halfspace(face.Dimension()),
+
+  // Make the lists where the rest of the frame's geometry is made
+  touching_corners(FrameArena::Resource()),
+  adjacent_faces(FrameArena::Resource()),
+  corner_set(FrameArena::Resource()),
+  adjacent_set(FrameArena::Resource())
 
 {
 
   // Copy the coefficients
   memmove(coordinates, face.coordinates, (dimension + 1) * sizeof(double));
 
+  index = -1;
+
 } //==== Face::Face() ====//
 
 
@@ -63,13 +79,21 @@ Face::Face(Face &face) :
 Face::Face(Halfspace& halfspace) :
 
   // Construct as a Halfspace
-  Halfspace(halfspace.Dimension())
+  Halfspace(halfspace.Dimension()),
+
+  // Make the lists where the rest of the frame's geometry is made
+  touching_corners(FrameArena::Resource()),
+  adjacent_faces(FrameArena::Resource()),
+  corner_set(FrameArena::Resource()),
+  adjacent_set(FrameArena::Resource())
 
 {
 
   // Copy the coefficients
   memmove(coordinates, halfspace.coordinates, (dimension + 1) * sizeof(double));
 
+  index = -1;
+
 } //==== Face::Face() ====//
 
 
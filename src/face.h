@@ -9,7 +9,9 @@
 #define HFACE
 
 
+#include "arena.h"
 #include "halfspace.h"
+#include "indexset.h"
 
 
 class Face : public Halfspace
@@ -19,10 +21,18 @@ class Face : public Halfspace
   friend class Solid;
   
   //  List of pointers to the corners which touch this face
-  std::vector<Vector *> touching_corners;
+  CornerList touching_corners;
 
   //  List of pointers to the Faces which touch this face
-  std::vector<Face *> adjacent_faces;
+  FaceList adjacent_faces;
+
+  //  The same corners and Faces, by their places in the corners and faces lists
+  //  of the Solid
+  IndexSet corner_set;
+  IndexSet adjacent_set;
+
+  //  The row of this Face in the face matrix of its Solid, or -1 if it isn't in one
+  long index;
   
 public:
   
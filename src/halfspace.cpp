@@ -98,7 +98,7 @@ void Halfspace::Negate(void)
 {
 
   // Negate all terms in the equation
-  register long i;
+  long i;
   for (i = 0; i <= dimension; i++)
     coordinates[i] = -coordinates[i];
 
@@ -174,13 +174,13 @@ void Halfspace::Transform(const AMatrix& m)
   //
   
   // Look for a non-zero coordinate
-  register long i;
+  long i;
   for (i = 0; i < dimension; i++)
     if (coordinates[i] != 0.0)
       break;
    
   // Find the intercept for this axis
-  register double intercept = -coordinates[dimension] / coordinates[i];
+  double intercept = -coordinates[dimension] / coordinates[i];
  
   // Transform the normal
   Vector transformedNormal(dimension);
@@ -198,12 +198,12 @@ void Halfspace::Transform(const AMatrix& m)
   //  directly into the transformed equation.
   //
   
-  register double sum = 0.0;
-  register long j;
+  double sum = 0.0;
+  long j;
   for (j = 0; j < dimension; j++) {
     
     // Get a coordinate of the transformed normal
-    register double coordinate = transformedNormal.coordinates[j];
+    double coordinate = transformedNormal.coordinates[j];
 
     // Copy it to this' coordinates
     coordinates[j] = coordinate;
@@ -278,11 +278,15 @@ void Halfspace::DumpEquation(void)
 void Halfspace::SliceSolid(Solid& solid, Solid*& inside_solid, Solid*& outside_solid)
 {
 
-  // Make inside_solid a copy of solid
-  inside_solid = new Solid(solid);
+  // Find the corners of solid before copying it, since this may remove redundant faces;
+  // the corners of the halves are then found from them.
+  solid.EnsureAdjacencies();
+
+  // Make inside_solid a copy of the Faces of solid
+  inside_solid = new Solid(solid, false);
 
-  // Make outside_solid a copy of solid
-  outside_solid = new Solid(solid);
+  // Make outside_solid a copy of the Faces of solid
+  outside_solid = new Solid(solid, false);
  
   // Make a new face, using this as the halfspace.
   Face *face = new Face(*this);
@@ -300,5 +304,38 @@ void Halfspace::SliceSolid(Solid& solid, Solid*& inside_solid, Solid*& outside_s
   // Add the flipped hyperplane to outside_solid's description.
   outside_solid->AddFace(face);
 
+  // Find the corners and adjacencies of the halves by cutting the corners of solid
+  solid.SliceAdjacencies(*inside_solid, *outside_solid);
+
+} //==== Halfspace::SliceSolid() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Halfspace::SliceSolid
+//|
+//| Purpose: This procedure slices a solid into two solids along the boundary of
+//|          this Halfspace.  The solid itself becomes the half inside this
+//|          Halfspace, keeping its Faces, so only the outside half is a copy.
+//|
+//| Parameters: solid:         the solid to slice; receives the half inside halfspace
+//|             outside_solid: receives the half of the solid outside halfspace
+//|_________________________________________________________________________________
+
+void Halfspace::SliceSolid(Solid& solid, Solid*& outside_solid)
+{
+
+  // Find the corners of solid before copying it, since this may remove redundant faces
+  solid.EnsureAdjacencies();
+
+  // Make outside_solid a copy of the Faces of solid, with the flipped hyperplane added
+  outside_solid = new Solid(solid, false);
+  Face *face = new Face(*this);
+  face->Negate();
+  outside_solid->AddFace(face);
+
+  // Add this halfspace to solid, and find the corners of both halves
+  solid.Slice(new Face(*this), *outside_solid);
+
 } //==== Halfspace::SliceSolid() ====//
 
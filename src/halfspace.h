@@ -35,6 +35,7 @@ public:
   void	Transform(const AMatrix& m);
 	    
   void	SliceSolid(Solid& solid, Solid*& inside_solid, Solid*& outside_solid);
+  void	SliceSolid(Solid& solid, Solid*& outside_solid);
 
 };
 
@@ -0,0 +1,162 @@
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| IndexSet.cpp
+//|
+//| This is the implementation of the IndexSet class.  An IndexSet is a set of
+//| small non-negative integers, kept as a bitset.
+//|_____________________________________________________________________________
+
+#include "indexset.h"
+
+
+//  The number of indices in each word
+#define INDEX_WORD_BITS	64
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| IndexSet::IndexSet
+//|
+//| Purpose: This method creates an empty IndexSet.
+//|
+//| Parameters: resource: where the words of the set get their memory
+//|_________________________________________________________________________________
+
+IndexSet::IndexSet(std::pmr::memory_resource *resource) :
+
+  words(resource)
+
+{
+
+} //==== IndexSet::IndexSet() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| IndexSet::Add
+//|
+//| Purpose: This method adds an index to this set.
+//|
+//| Parameters: index: the index to add
+//|_________________________________________________________________________________
+
+void IndexSet::Add(long index)
+{
+
+  unsigned long word = index / INDEX_WORD_BITS;
+  if (word >= words.size())
+    words.resize(word + 1, 0);
+
+  words[word] |= 1ULL << (index % INDEX_WORD_BITS);
+
+} //==== IndexSet::Add() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| IndexSet::Contains
+//|
+//| Purpose: This method checks whether an index is in this set.
+//|
+//| Parameters: index: the index to check
+//|             returns true if index is in this set
+//|_________________________________________________________________________________
+
+bool IndexSet::Contains(long index) const
+{
+
+  unsigned long word = index / INDEX_WORD_BITS;
+  if (word >= words.size())
+    return false;
+
+  return (words[word] >> (index % INDEX_WORD_BITS)) & 1;
+
+} //==== IndexSet::Contains() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| IndexSet::Clear
+//|
+//| Purpose: This method removes all indices from this set.
+//|
+//| Parameters: none
+//|_________________________________________________________________________________
+
+void IndexSet::Clear(void)
+{
+
+  words.clear();
+
+} //==== IndexSet::Clear() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| IndexSet::Assign
+//|
+//| Purpose: This method makes this set contain the same indices as another.
+//|
+//| Parameters: set: the set to copy
+//|_________________________________________________________________________________
+
+void IndexSet::Assign(const IndexSet& set)
+{
+
+  words.assign(set.words.begin(), set.words.end());
+
+} //==== IndexSet::Assign() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| IndexSet::CountCommon
+//|
+//| Purpose: This method counts the indices which are in both this set and
+//|          another.
+//|
+//| Parameters: set: the other set
+//|             returns the number of indices in both sets
+//|_________________________________________________________________________________
+
+long IndexSet::CountCommon(const IndexSet& set) const
+{
+
+  unsigned long num_words = (words.size() < set.words.size()) ? words.size() : set.words.size();
+
+  long count = 0;
+  for (unsigned long i = 0; i < num_words; i++)
+    count += __builtin_popcountll(words[i] & set.words[i]);
+
+  return count;
+
+} //==== IndexSet::CountCommon() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| IndexSet::FirstNotIn
+//|
+//| Purpose: This method finds the smallest index which is in this set but not
+//|          in another.
+//|
+//| Parameters: set: the other set
+//|             returns the index, or -1 if every index in this set is in set
+//|_________________________________________________________________________________
+
+long IndexSet::FirstNotIn(const IndexSet& set) const
+{
+
+  for (unsigned long i = 0; i < words.size(); i++) {
+
+    unsigned long long word = words[i];
+    if (i < set.words.size())
+      word &= ~set.words[i];
+
+    if (word)
+      return i*INDEX_WORD_BITS + __builtin_ctzll(word);
+
+  }
+
+  return -1;
+
+} //==== IndexSet::FirstNotIn() ====//
@@ -0,0 +1,40 @@
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| IndexSet.h
+//|
+//| This is the interface to the IndexSet class.  An IndexSet is a set of small
+//| non-negative integers, kept as a bitset.  Faces use them to record which
+//| corners of their Solid touch them, and which other Faces are adjacent to
+//| them, by their places in the Solid's corners and faces lists, so that
+//| membership, counting common members and finding a member of one set which
+//| is not in another take a few word operations.
+//|_____________________________________________________________________________
+
+#ifndef HINDEXSET
+#define HINDEXSET
+
+
+#include <memory_resource>
+#include <vector>
+
+
+class IndexSet
+{
+
+  //  Bit i of word i/64 is set if i is in this set
+  std::pmr::vector<unsigned long long> words;
+
+public:
+
+  IndexSet(std::pmr::memory_resource *resource);
+
+  void Add(long index);
+  bool Contains(long index) const;
+  void Clear(void);
+  void Assign(const IndexSet& set);
+
+  long CountCommon(const IndexSet& set) const;
+  long FirstNotIn(const IndexSet& set) const;
+
+};
+
+#endif
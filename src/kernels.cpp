@@ -0,0 +1,158 @@
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Kernels.cpp
+//|
+//| This is the implementation of the dimension kernels.  Each kernel is a
+//| template on the dimension N; N = 0 is the general version, which uses the
+//| dimension it is passed instead.  With N fixed the compiler knows every trip
+//| count and unrolls the loops completely.
+//|_____________________________________________________________________________
+
+#include "kernels.h"
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Procedure Evaluate
+//|
+//| Purpose: This procedure plugs a point into the equation of a halfspace.
+//|
+//| Parameters: dimension: the dimension of the space, if N is 0
+//|             halfspace: the coefficients of the halfspace
+//|             point:     the coordinates of the point
+//|             returns a1*x1 + ... + an*xn + k
+//|_________________________________________________________________________________
+
+template <long N>
+static double Evaluate(long dimension, const double *halfspace, const double *point)
+{
+
+  const long n = N ? N : dimension;
+
+  double result = 0.0;
+  for (long k = 0; k < n; k++)
+    result += halfspace[k] * point[k];
+
+  return result + halfspace[n];
+
+} //==== Evaluate() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Procedure RowsAbove
+//|
+//| Purpose: This procedure checks a point against each row of a halfspace matrix,
+//|          stopping at the first one it isn't above the limit for.
+//|
+//| Parameters: dimension: the dimension of the space, if N is 0
+//|             matrix:    the first row
+//|             stride:    the distance between rows, in doubles
+//|             num_rows:  the number of rows
+//|             point:     the coordinates of the point
+//|             limit:     the value each row must exceed
+//|             returns true if every row evaluates to more than limit
+//|_________________________________________________________________________________
+
+template <long N>
+static bool RowsAbove(long dimension, const double *matrix, long stride, long num_rows,
+		      const double *point, double limit)
+{
+
+  const long n = N ? N : dimension;
+
+  for (long i = 0; i < num_rows; i++, matrix += stride) {
+    double result = 0.0;
+    for (long k = 0; k < n; k++)
+      result += matrix[k] * point[k];
+    result += matrix[n];
+    if (result <= limit)
+      return false;
+  }
+
+  return true;
+
+} //==== RowsAbove() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Procedure Eliminate
+//|
+//| Purpose: This procedure subtracts a multiple of one equation from another.
+//|
+//| Parameters: dimension: the dimension of the space, if N is 0
+//|             row:       the equation to subtract from
+//|             pivot:     the equation to subtract
+//|             factor:    the multiple of pivot to subtract
+//|_________________________________________________________________________________
+
+template <long N>
+static void Eliminate(long dimension, double *row, const double *pivot, double factor)
+{
+
+  const long n = N ? N : dimension;
+
+  for (long k = 0; k <= n; k++)
+    row[k] -= factor * pivot[k];
+
+} //==== Eliminate() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Procedure Interpolate
+//|
+//| Purpose: This procedure finds a point part way along a line segment.
+//|
+//| Parameters: dimension: the dimension of the space, if N is 0
+//|             result:    receives the point
+//|             from:      the start of the segment
+//|             to:        the end of the segment
+//|             t:         the fraction of the way from from to to
+//|_________________________________________________________________________________
+
+template <long N>
+static void Interpolate(long dimension, double *result, const double *from, const double *to, double t)
+{
+
+  const long n = N ? N : dimension;
+
+  for (long k = 0; k < n; k++)
+    result[k] = from[k] + t * (to[k] - from[k]);
+
+} //==== Interpolate() ====//
+
+
+
+//
+//  The kernel table.  Entry N holds the kernels compiled for dimension N, and
+//  entry 0 the general ones.
+//
+
+#define KERNELS(N)	{ N, Evaluate<N>, RowsAbove<N>, Eliminate<N>, Interpolate<N> }
+
+static const DimensionKernels kernel_table[MAX_FIXED_DIMENSION+1] =
+{
+  KERNELS(0), KERNELS(1), KERNELS(2), KERNELS(3), KERNELS(4), KERNELS(5), KERNELS(6)
+};
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Procedure GetDimensionKernels
+//|
+//| Purpose: This procedure finds the kernels to use in a given dimension.
+//|
+//| Parameters: dimension: the dimension of the space
+//|             returns the compiled kernels for dimension, or the general ones if
+//|             there aren't any
+//|_________________________________________________________________________________
+
+const DimensionKernels *GetDimensionKernels(long dimension)
+{
+
+  if ((dimension >= 1) && (dimension <= MAX_FIXED_DIMENSION))
+    return &kernel_table[dimension];
+
+  return &kernel_table[0];
+
+} //==== GetDimensionKernels() ====//
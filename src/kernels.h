@@ -0,0 +1,54 @@
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Kernels.h
+//|
+//| This is the interface to the dimension kernels.  These are the innermost
+//| loops of the geometry (evaluating halfspaces at points, eliminating one
+//| equation with another, and so on), compiled once for each dimension from 1
+//| to MAX_FIXED_DIMENSION so the loops have fixed trip counts and unroll.  A
+//| Solid looks up the kernels for its dimension when it is created; dimensions
+//| above MAX_FIXED_DIMENSION get kernels which loop over the dimension passed.
+//|_____________________________________________________________________________
+
+#ifndef HKERNELS
+#define HKERNELS
+
+
+//  The largest dimension with its own compiled kernels
+#define MAX_FIXED_DIMENSION	6
+
+
+//
+//  The kernels for one dimension.  Halfspaces are dimension+1 coefficients, the
+//  last being the constant; points are dimension coordinates.  Every kernel is
+//  passed the dimension, which only the general kernels look at.
+//
+
+class DimensionKernels
+{
+
+public:
+
+  //  The dimension these kernels are for, or 0 for the general ones
+  long dimension;
+
+  //  Returns a1*x1 + ... + an*xn + k for halfspace a and point x
+  double (*evaluate)(long dimension, const double *halfspace, const double *point);
+
+  //  Returns true if point evaluates to more than limit in each of num_rows
+  //  halfspaces, stored stride doubles apart starting at matrix
+  bool (*rows_above)(long dimension, const double *matrix, long stride, long num_rows,
+		     const double *point, double limit);
+
+  //  Subtracts factor times equation pivot from equation row (dimension+1 terms)
+  void (*eliminate)(long dimension, double *row, const double *pivot, double factor);
+
+  //  Sets result to the point the fraction t of the way from point from to point to
+  void (*interpolate)(long dimension, double *result, const double *from, const double *to, double t);
+
+};
+
+
+const DimensionKernels *GetDimensionKernels(long dimension);
+
+
+#endif
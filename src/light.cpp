@@ -73,7 +73,7 @@ void Light::Apply(Vector& normal, double &cRed, double &cGreen, double &cBlue)
 {
 
   // Dot the light direction with the normalized normal of Face.
-  register double intensity = -(normal * (*this));
+  double intensity = -(normal * (*this));
 
   // Face is a backface, from light's perspective
   if (intensity < 0)
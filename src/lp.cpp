@@ -0,0 +1,240 @@
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| LP.cpp
+//|
+//| This is the implementation of the linear program solver.  See LP.h.
+//|_____________________________________________________________________________
+
+#include "lp.h"
+#include "adsoda_types.h"
+
+#include <math.h>
+#include <random>
+#include <string.h>
+#include <vector>
+
+
+//  The seed the halfspaces are shuffled with, so the same problem always gives the
+//  same point
+#define LP_SHUFFLE_SEED		1999
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Procedure NormalizeRow
+//|
+//| Purpose: This procedure scales a halfspace so its normal has unit length, so
+//|          values of it at points are distances.  A row with no normal is left
+//|          alone.
+//|
+//| Parameters: dimension: the dimension of the space
+//|             row:       the halfspace
+//|_________________________________________________________________________________
+
+static void NormalizeRow(long dimension, double *row)
+{
+
+  double length = 0;
+  for (long k = 0; k < dimension; k++)
+    length += row[k] * row[k];
+  length = sqrt(length);
+
+  if (length > VERY_SMALL_NUM)
+    for (long k = 0; k <= dimension; k++)
+      row[k] /= length;
+
+} //==== NormalizeRow() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Procedure ScratchSize
+//|
+//| Purpose: This procedure returns how many doubles Minimize needs for the
+//|          halfspaces, objective and solution of all the problems it solves one
+//|          or more dimensions lower.
+//|
+//| Parameters: dimension: the number of variables
+//|             num_rows:  the number of halfspaces
+//|_________________________________________________________________________________
+
+static long ScratchSize(long dimension, long num_rows)
+{
+
+  long size = 0;
+  for (; dimension > 0; dimension--) {
+
+    //  The lower problem has the halfspaces before the one cutting off the best
+    //  point, and the two bounds of the pivot variable
+    num_rows += 2;
+    size += num_rows * dimension + (dimension + 1) + 2 * (dimension - 1);
+
+  }
+
+  return size;
+
+} //==== ScratchSize() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Procedure Minimize
+//|
+//| Purpose: This procedure does the work of MinimizeOverHalfspaces, taking the
+//|          halfspaces in the order given.  The problems one dimension lower are
+//|          built in scratch, which is carved up as they go deeper.
+//|
+//| Parameters: dimension: the number of variables
+//|             rows:      the halfspaces, dimension+1 doubles each
+//|             num_rows:  the number of halfspaces
+//|             objective: dimension coefficients of the objective
+//|             bound:     half the width of the box
+//|             solution:  receives dimension coordinates of the best point
+//|             scratch:   ScratchSize(dimension, num_rows) doubles
+//|             returns false if the halfspaces and the box have no point in
+//|             common
+//|_________________________________________________________________________________
+
+static bool Minimize(long dimension, const double *rows, long num_rows,
+		     const double *objective, double bound, double *solution, double *scratch)
+{
+
+  long k;
+  long stride = dimension + 1;
+
+  //  With no variables left, the halfspaces are constants, which must all be satisfied
+  if (dimension == 0) {
+    for (long i = 0; i < num_rows; i++)
+      if (rows[i] < -VERY_SMALL_NUM)
+	return false;
+    return true;
+  }
+
+  //  Start from the best corner of the box
+  for (k = 0; k < dimension; k++)
+    solution[k] = (objective[k] > 0) ? -bound : bound;
+
+  double *lower_rows = scratch;
+  double *box_row = lower_rows + (num_rows + 2) * dimension;
+  double *lower_objective = box_row + stride;
+  double *lower_solution = lower_objective + (dimension - 1);
+  double *lower_scratch = lower_solution + (dimension - 1);
+
+  for (long i = 0; i < num_rows; i++) {
+
+    //  If the best point so far is inside this halfspace, it is still the best point
+    const double *row = rows + i*stride;
+    double value = row[dimension];
+    for (k = 0; k < dimension; k++)
+      value += row[k] * solution[k];
+    if (value >= -VERY_SMALL_NUM)
+      continue;
+
+    //  Otherwise the best point is on the boundary of this halfspace.  Solve for the
+    //  variable with the largest coefficient, and substitute it into the halfspaces
+    //  before this one, the objective, and its bounds in the box.
+    long pivot = 0;
+    for (k = 1; k < dimension; k++)
+      if (fabs(row[k]) > fabs(row[pivot]))
+	pivot = k;
+    if (fabs(row[pivot]) <= VERY_SMALL_NUM)
+      return false;
+
+    long lower_stride = dimension;
+    long num_lower_rows = i + 2;
+
+    for (long j = 0; j < num_lower_rows; j++) {
+
+      double *lower_row = &lower_rows[j*lower_stride];
+
+      //  The bounds on the pivot variable:  xp + bound >= 0  and  -xp + bound >= 0
+      const double *upper_row;
+      if (j < i)
+	upper_row = rows + j*stride;
+      else {
+	for (k = 0; k < dimension; k++)
+	  box_row[k] = 0;
+	box_row[pivot] = (j == i) ? 1 : -1;
+	box_row[dimension] = bound;
+	upper_row = box_row;
+      }
+
+      double factor = upper_row[pivot] / row[pivot];
+      long lower_k = 0;
+      for (k = 0; k <= dimension; k++)
+	if (k != pivot)
+	  lower_row[lower_k++] = upper_row[k] - factor * row[k];
+
+      NormalizeRow(dimension - 1, lower_row);
+
+    }
+
+    double factor = objective[pivot] / row[pivot];
+    long lower_k = 0;
+    for (k = 0; k < dimension; k++)
+      if (k != pivot)
+	lower_objective[lower_k++] = objective[k] - factor * row[k];
+
+    if (!Minimize(dimension - 1, lower_rows, num_lower_rows, lower_objective, bound,
+		  lower_solution, lower_scratch))
+      return false;
+
+    //  Put the pivot variable back
+    double pivot_value = row[dimension];
+    lower_k = 0;
+    for (k = 0; k < dimension; k++)
+      if (k != pivot) {
+	solution[k] = lower_solution[lower_k++];
+	pivot_value += row[k] * solution[k];
+      }
+    solution[pivot] = -pivot_value / row[pivot];
+
+  }
+
+  return true;
+
+} //==== Minimize() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| MinimizeOverHalfspaces
+//|
+//| Purpose: This procedure finds a point which minimizes objective over the
+//|          intersection of a set of halfspaces and the box |xk| <= bound.  The
+//|          halfspaces are shuffled with a fixed seed, and all the memory the
+//|          problems of lower dimension need is allocated once, up front.
+//|
+//| Parameters: dimension: the number of variables
+//|             rows:      the halfspaces, dimension+1 doubles each; each row
+//|                        should be normalized
+//|             num_rows:  the number of halfspaces
+//|             objective: dimension coefficients of the objective
+//|             bound:     half the width of the box
+//|             solution:  receives dimension coordinates of the best point
+//|             returns false if the halfspaces and the box have no point in
+//|             common
+//|_________________________________________________________________________________
+
+bool MinimizeOverHalfspaces(long dimension, const double *rows, long num_rows,
+			    const double *objective, double bound, double *solution)
+{
+
+  long stride = dimension + 1;
+
+  //  The shuffled halfspaces, followed by the scratch space
+  std::vector<double> memory(num_rows * stride + ScratchSize(dimension, num_rows));
+  double *shuffled_rows = memory.data();
+
+  //  Take the halfspaces in a random order, which is what keeps the expected time linear
+  std::minstd_rand random(LP_SHUFFLE_SEED);
+  for (long i = 0; i < num_rows; i++) {
+    long j = random() % (i + 1);
+    if (j != i)
+      memmove(shuffled_rows + i*stride, shuffled_rows + j*stride, stride * sizeof(double));
+    memmove(shuffled_rows + j*stride, rows + i*stride, stride * sizeof(double));
+  }
+
+  return Minimize(dimension, shuffled_rows, num_rows, objective, bound, solution,
+		  shuffled_rows + num_rows * stride);
+
+} //==== MinimizeOverHalfspaces() ====//
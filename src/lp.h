@@ -0,0 +1,27 @@
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| LP.h
+//|
+//| This is the interface to a small linear program solver.  It finds the point
+//| which minimizes a linear objective inside an intersection of halfspaces and
+//| a large box, by Seidel's incremental method:  the halfspaces are added one at
+//| a time, and when one cuts off the best point so far, the new best point is
+//| found on its boundary by solving the same problem one dimension lower.  The
+//| halfspaces are taken in a random order, shuffled with a fixed seed so the
+//| same problem always gives the same point; for the few dimensions of a Solid
+//| the expected time is then linear in the number of halfspaces.
+//|_____________________________________________________________________________
+
+#ifndef HLP
+#define HLP
+
+
+//
+//  The halfspaces are rows of dimension+1 doubles, stored one after another:
+//  the row {a1, ..., an, k} is the halfspace a1*x1 + ... + an*xn + k >= 0.  The
+//  box is |xk| <= bound for every k.
+//
+
+bool MinimizeOverHalfspaces(long dimension, const double *rows, long num_rows,
+			    const double *objective, double bound, double *solution);
+
+#endif
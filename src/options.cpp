@@ -1,6 +1,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "state.h"
+#include "enumerator.h"
 #include <iostream>
 
 
@@ -53,6 +54,31 @@ void parseArgs(State &state, int numArgs, char **args) {
     else if (!strcasecmp(option, "-drawcube"))
       state.drawcubeFlag = true;
 
+    else if (!strcasecmp(option, "-enumerator")) {
+      i++;
+      int enumerator = VertexEnumerator::LookupVertexEnumerator(args[i]);
+      if (enumerator < 0)
+	std::cout << "#### ERROR unknown ADSODA vertex enumerator: #" << args[i] << "#" << std::endl;
+      else
+	state.vertexEnumerator = enumerator;
+    }
+
+    else if (!strcasecmp(option, "-threads")) {
+      i++;
+      state.numThreads = atoi(args[i]);
+    }
+
+    else if (!strcasecmp(option, "-noarena"))
+      state.useArena = false;
+
+    else if (!strcasecmp(option, "-fragmentBudget")) {
+      i++;
+      state.fragmentBudget = atoi(args[i]);
+    }
+
+    else if (!strcasecmp(option, "-stats"))
+      state.printStats = true;
+
     else
       std::cout << "#### ERROR unknown ADSODA option: #" << option << "#" << std::endl;
 
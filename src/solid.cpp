@@ -6,9 +6,13 @@
 //|_____________________________________________________________________________
 
 #include "adsoda_types.h"
+#include "amatrix.h"
+#include "enumerator.h"
 #include "face.h"
 #include "intersect.h"
+#include "kernels.h"
 #include "light.h"
+#include "lp.h"
 #include "vector.h"
 #include "solid.h"
 #include "debug.h"
@@ -17,6 +21,9 @@
 #include <iostream>
 #include <float.h>
 #include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <unordered_map>
 //#include <algo.h>
 #include <math.h>
 
@@ -41,6 +48,12 @@ extern bool LeftSide(double start_h, double start_v, double end_h, double end_v,
 //extern long znear,zfar;
 //extern int cube,thick;
 
+//  The engine FindAdjacencies uses to find corners
+VertexEnumerator *Solid::vertex_enumerator = VertexEnumerator::GetVertexEnumerator(DOUBLE_DESCRIPTION_ENUMERATOR);
+
+//  How OrderSolids has decided
+OrderStats Solid::order_stats = { 0, 0, 0, 0 };
+
 
 
 
@@ -52,10 +65,20 @@ extern bool LeftSide(double start_h, double start_v, double end_h, double end_v,
 //| Parameters: dim: dimension of the solid
 //|_________________________________________________________________________________
 
-Solid::Solid(long dim)
+Solid::Solid(long dim) :
+
+  //  Make the lists where the rest of the frame's geometry is made
+  faces(FrameArena::Resource()),
+  corners(FrameArena::Resource()),
+  bounds(FrameArena::Resource()),
+  front_faces(FrameArena::Resource()),
+  unit_normals(FrameArena::Resource()),
+  corner_cells(FrameArena::Resource())
+
 {
   
   dimension = dim;
+  InitFaceMatrix();
 
   color.red = 0;
   color.green = 0;
@@ -66,6 +89,9 @@ Solid::Solid(long dim)
 
   //  Adjacencies not yet computed
   adjacencies_valid = false;
+  bounded = false;
+  bounds_valid = false;
+  orientation_valid = false;
 
 }  //==== Solid::Solid() ====//
 
@@ -75,24 +101,41 @@ Solid::Solid(long dim)
 //| Solid::Solid
 //|
 //| Purpose: This method creates a copy of this solid which is a copy of another
-//|          Solid
-//|
-//| Parameters: solid: the Solid to duplicate.
+//|          Solid.  If the adjacencies of solid are valid, its corners, the
+//|          touching_corners and adjacent_faces lists of its Faces, and its
+//|          silhouette are copied too, so the copy doesn't have to find them
+//|          again.
+//|
+//| Parameters: solid:            the Solid to duplicate.
+//|             copy_adjacencies: false to copy only the Faces, when the copy
+//|                               is about to be changed anyway
 //|_________________________________________________________________________________
 
-Solid::Solid(Solid& solid)
+Solid::Solid(Solid& solid, bool copy_adjacencies) :
   // : Faces(solid.faces),        //  Copy the Faces list
   // : Corners(solid.corners)       //  Copy the Corners list
+
+  //  Make the lists where the rest of the frame's geometry is made
+  faces(FrameArena::Resource()),
+  corners(FrameArena::Resource()),
+  bounds(FrameArena::Resource()),
+  front_faces(FrameArena::Resource()),
+  unit_normals(FrameArena::Resource()),
+  corner_cells(FrameArena::Resource())
+
 {
  
   //  Set dimension to same as dimension of solid
   dimension = solid.dimension;
+  InitFaceMatrix();
 
   //  Copy the color of the Solid
   color = solid.color;
 
-  // Copy the faces
-  for (std::vector<Face *>::iterator face = solid.faces.begin(); face != solid.faces.end(); face++)    
+  // Copy the faces, leaving room for the one SliceSolid adds
+  faces.reserve(solid.faces.size() + 1);
+  ReserveFaces(solid.faces.size() + 1);
+  for (FaceList::iterator face = solid.faces.begin(); face != solid.faces.end(); face++)    
     AddFace(new Face(**face));
 
   //  No silhouette computed yet
@@ -100,6 +143,65 @@ Solid::Solid(Solid& solid)
 
   //  Adjacencies not yet computed
   adjacencies_valid = false;
+  bounded = false;
+  bounds_valid = false;
+  orientation_valid = false;
+
+  //  Nothing about solid has changed, so its adjacencies and silhouette are still right
+  if (copy_adjacencies && solid.adjacencies_valid) {
+    CopyAdjacencies(solid);
+    if (solid.silhouette)
+      silhouette = new Solid(*solid.silhouette);
+  }
+
+} //==== Solid::Solid() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::Solid
+//|
+//| Purpose: This method creates a Solid by taking over the faces, corners, face
+//|          matrix and silhouette of another Solid, which is left empty.  Nothing
+//|          is copied.
+//|
+//| Parameters: solid: the Solid to take over
+//|_________________________________________________________________________________
+
+Solid::Solid(Solid&& solid) :
+
+  //  Take the lists; they keep the memory they were made in
+  faces(std::move(solid.faces)),
+  corners(std::move(solid.corners)),
+  bounds(std::move(solid.bounds)),
+  front_faces(std::move(solid.front_faces)),
+  unit_normals(std::move(solid.unit_normals)),
+  corner_cells(FrameArena::Resource())
+
+{
+
+  dimension = solid.dimension;
+  color = solid.color;
+
+  //  The Faces still point at their rows of the face matrix
+  face_matrix = solid.face_matrix;
+  face_stride = solid.face_stride;
+  face_capacity = solid.face_capacity;
+  kernels = solid.kernels;
+  solid.face_matrix = NULL;
+  solid.face_capacity = 0;
+
+  silhouette = solid.silhouette;
+  solid.silhouette = NULL;
+
+  adjacencies_valid = solid.adjacencies_valid;
+  bounded = solid.bounded;
+  bounds_valid = solid.bounds_valid;
+  orientation_valid = solid.orientation_valid;
+  solid.adjacencies_valid = false;
+  solid.bounded = false;
+  solid.bounds_valid = false;
+  solid.orientation_valid = false;
 
 } //==== Solid::Solid() ====//
 
@@ -117,21 +219,76 @@ Solid::~Solid(void)
 {
 
   // delete all faces from the faces list
-  for (std::vector<Face *>::iterator face = faces.begin(); face != faces.end(); face++)
+  for (FaceList::iterator face = faces.begin(); face != faces.end(); face++)
     delete(*face);
 
   // delete all corners in the corners list
-  for (std::vector<Vector *>::iterator corner = corners.begin(); corner != corners.end(); corner++)
+  for (CornerList::iterator corner = corners.begin(); corner != corners.end(); corner++)
     delete(*corner);
 
   //  Get rid of silhouette, if any
   if (silhouette)
     delete(silhouette);
 
+  //  The faces are gone, so no one is using the face matrix
+  free(face_matrix);
+
 } //==== Solid::~Solid() ====//
 
 
 
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::operator new
+//|
+//| Purpose: This method allocates memory for a Solid, from the frame arena
+//|          during a frame.
+//|
+//| Parameters: size: the size of the Solid
+//|             returns the memory for it
+//|_________________________________________________________________________________
+
+void *Solid::operator new(size_t size)
+{
+
+  return FrameArena::AllocateObject(size);
+
+} //==== Solid::operator new() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::operator delete
+//|
+//| Purpose: This method frees the memory of a Solid.
+//|
+//| Parameters: object: the memory of the Solid
+//|_________________________________________________________________________________
+
+void Solid::operator delete(void *object)
+{
+
+  FrameArena::FreeObject(object);
+
+} //==== Solid::operator delete() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::Faces
+//|
+//| Purpose: This method gets the faces of this solid
+//|
+//| Parameters: returns the faces vector
+//|_________________________________________________________________________________
+
+const FaceList &Solid::Faces(void) const {
+  
+  return faces;
+  
+}  //==== Faces() ====//
+
+
+
 //|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //| Solid::Corners
 //|
@@ -140,7 +297,7 @@ Solid::~Solid(void)
 //| Parameters: returns the corners vector
 //|_________________________________________________________________________________
 
-const std::vector<Vector *> &Solid::Corners(void) const {
+const CornerList &Solid::Corners(void) const {
   
   return corners;
   
@@ -148,6 +305,59 @@ const std::vector<Vector *> &Solid::Corners(void) const {
 
 
 
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::SetVertexEnumerator
+//|
+//| Purpose: This method selects the engine FindAdjacencies uses to find the
+//|          corners of all Solids.
+//|
+//| Parameters: which: DOUBLE_DESCRIPTION_ENUMERATOR or COMBINATION_ENUMERATOR
+//|_________________________________________________________________________________
+
+void Solid::SetVertexEnumerator(int which) {
+
+  vertex_enumerator = VertexEnumerator::GetVertexEnumerator(which);
+
+}  //==== Solid::SetVertexEnumerator() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::ClearOrderStats
+//|
+//| Purpose: This method starts counting the ways OrderSolids decides over.
+//|
+//| Parameters: none
+//|_________________________________________________________________________________
+
+void Solid::ClearOrderStats(void) {
+
+  order_stats.box_separated = 0;
+  order_stats.face_separated = 0;
+  order_stats.depth_ordered = 0;
+  order_stats.corner_tested = 0;
+
+}  //==== Solid::ClearOrderStats() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::GetOrderStats
+//|
+//| Purpose: This method returns how many times OrderSolids has decided each way
+//|          since the counts were cleared.
+//|
+//| Parameters: stats: receives the counts
+//|_________________________________________________________________________________
+
+void Solid::GetOrderStats(OrderStats& stats) {
+
+  stats = order_stats;
+
+}  //==== Solid::GetOrderStats() ====//
+
+
+
 //|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //| Solid::SetColor
 //|
@@ -231,7 +441,7 @@ void Solid::GetColor(Color& the_color)
 void Solid::DumpAdjacencies(void)
 {
   
-  for (std::vector<Face *>::iterator face = faces.begin(); face != faces.end(); face++) {
+  for (FaceList::iterator face = faces.begin(); face != faces.end(); face++) {
 
     // Get this face
     Face *this_face = *face;
@@ -250,7 +460,7 @@ void Solid::DumpAdjacencies(void)
   
     std::cout << "\n\n  Touching corners:  ";
     
-    for (std::vector<Vector *>::iterator corner = this_face->touching_corners.begin();
+    for (CornerList::iterator corner = this_face->touching_corners.begin();
 	 corner != this_face->touching_corners.end();
 	 corner++) {
       
@@ -282,7 +492,7 @@ void Solid::DumpAdjacencies(void)
 void Solid::DumpFaces(void)
 {
   
-  for (std::vector<Face *>::iterator face = faces.begin(); face != faces.end(); face++) {
+  for (FaceList::iterator face = faces.begin(); face != faces.end(); face++) {
     (*face)->DumpEquation();
     std::cout << '\n';
   }
@@ -326,137 +536,373 @@ void Solid::EnsureAdjacencies(void) {
 void Solid::FindAdjacencies(void)
 {
 
-  register long i;
-  
+  ClearAdjacencies();
+
+  //  Faces which don't cut this Solid would only make the enumerator work harder.  A
+  //  Solid with no more faces than a box seldom has any, and isn't worth checking.
+  if (faces.size() > 2 * dimension)
+    RemoveRedundantFaces();
+
+  //  Find the corners.  The enumerator calls ProcessCorner for each corner it finds, which
+  //  sets up the touching_corners and adjacent_faces lists.
+  bool corners_bounded = vertex_enumerator->FindCorners(*this);
+
+  FinishAdjacencies(corners_bounded);
+
+}  //==== Solid::FindAdjacencies() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::RemoveRedundantFaces
+//|
+//| Purpose: This method removes the Faces of this Solid which don't cut it, before
+//|          its corners are found.  A Face is redundant if no point inside all the
+//|          other Faces is more than VERY_SMALL_NUM outside it, which is found by
+//|          minimizing the Face over the others with a linear program.  Faces are
+//|          checked in order against the Faces not yet removed, so of two copies
+//|          of the same Face only one is removed.  If the Faces have no point in
+//|          common, nothing is removed.  The adjacencies must be found again
+//|          afterward.
+//|
+//| Parameters: none
+//|_________________________________________________________________________________
+
+void Solid::RemoveRedundantFaces(void)
+{
+
+  long num_faces = faces.size();
+  long stride = dimension + 1;
+  long i, j, k;
+
+  //  The Faces, scaled so their normals have unit length
+  std::vector<double> rows(num_faces * stride);
+  std::vector<bool> usable(num_faces);
+  for (i = 0; i < num_faces; i++) {
+
+    double *row = &rows[i*stride];
+    memmove(row, faces[i]->coordinates, stride * sizeof(double));
+
+    double length = 0;
+    for (k = 0; k < (long) dimension; k++)
+      length += row[k] * row[k];
+    length = sqrt(length);
+
+    //  A Face with no normal isn't checked; it is either everywhere or nowhere
+    usable[i] = (length > VERY_SMALL_NUM);
+    if (usable[i])
+      for (k = 0; k < stride; k++)
+	row[k] /= length;
+
+  }
+
+  std::vector<bool> redundant(num_faces, false);
+  std::vector<double> others(num_faces * stride);
+  std::vector<double> solution(dimension);
+  for (i = 0; i < num_faces; i++) {
+
+    if (!usable[i])
+      continue;
+
+    //  The Faces other than this one which are still here
+    long num_others = 0;
+    for (j = 0; j < num_faces; j++)
+      if ((j != i) && !redundant[j])
+	memmove(&others[stride * num_others++], &rows[j*stride], stride * sizeof(double));
+
+    //  Find the point inside the others which is farthest outside this Face
+    const double *row = &rows[i*stride];
+    if (!MinimizeOverHalfspaces(dimension, others.data(), num_others, row, BOUNDING_BOX_SIZE, solution.data()))
+      return;
+
+    double value = row[dimension];
+    for (k = 0; k < (long) dimension; k++)
+      value += row[k] * solution[k];
+    redundant[i] = (value >= -VERY_SMALL_NUM);
+
+  }
+
+  //  Remove the redundant Faces, and close up their rows
+  FaceList::iterator kept = faces.begin();
+  for (i = 0; i < num_faces; i++) {
+    if (redundant[i])
+      delete(faces[i]);
+    else
+      *kept++ = faces[i];
+  }
+  faces.erase(kept, faces.end());
+
+  PackFaces();
+
+  adjacencies_valid = false;
+
+}  //==== Solid::RemoveRedundantFaces() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::ClearAdjacencies
+//|
+//| Purpose: This method deletes the corners of this Solid, and clears the
+//|          touching_corners and adjacent_faces lists of its Faces, before the
+//|          corners are found again.
+//|
+//| Parameters: none
+//|_________________________________________________________________________________
+
+void Solid::ClearAdjacencies(void)
+{
+
   //  delete all corners in this list
-  for (std::vector<Vector *>::iterator corner = corners.begin(); corner != corners.end(); corner++)
+  for (CornerList::iterator corner = corners.begin(); corner != corners.end(); corner++)
     delete(*corner);
   corners.erase(corners.begin(), corners.end());
+  corner_cells.clear();
+  bounds_valid = false;
 
   //  Loop through all faces of this Solid
-  std::vector<Face *>::iterator face;
-  for (face = faces.begin(); face != faces.end(); face++) {
+  for (FaceList::iterator face = faces.begin(); face != faces.end(); face++) {
     
     // Clear touching corners and adjacent faces list for this face
-    std::vector<Vector *> &tcorners = (*face)->touching_corners;
-    //    for (std::vector<Vector *>::iterator tcorner = tcorners.begin(); tcorner != tcorners.end(); tcorner++)
-    //      delete(*tcorner);
+    CornerList &tcorners = (*face)->touching_corners;
     tcorners.erase(tcorners.begin(), tcorners.end());
 
-    std::vector<Face *> &afaces = (*face)->adjacent_faces;
-//    for (std::vector<Face *>::iterator aface = afaces.begin(); aface != afaces.end(); aface++)
-    //      delete(*aface);
+    FaceList &afaces = (*face)->adjacent_faces;
     afaces.erase(afaces.begin(), afaces.end());
 
+    (*face)->corner_set.Clear();
+    (*face)->adjacent_set.Clear();
+
   } 
 
-  //
-  //  The following algorithm finds all combinations of Faces of this Solid which can intersect
-  //  in a point, and finds their intersection.  For each intersection it calls ProcessCorner to
-  //  check if the intersection is a corner, and to update the appropriate adjacencies if it is.
-  //
-  //  The most complex code below is the code which determines which faces to intersect.  It
-  //  functions like a dimension-digit counter, counting faces in the indices[] array.  It counts
-  //  through all decreasing combinations of the faces; this ensures that no combinations will be
-  //  missed, but that no combination will be duplicated.
-  //
+}  //==== Solid::ClearAdjacencies() ====//
 
-  //  This is the list of Faces to intersect.
-  std::vector<Face *> intersected_faces;
 
-  //  Allocate space for the indices array
-  register unsigned long *indices = (unsigned long *) malloc(dimension * sizeof(unsigned long));
-  ASSERT(indices != NULL);
- 
-  //  Initialize indices to minimum values
-  unsigned long j;
-  for (j = 0; j < dimension; j++)
-    indices[j] = dimension - j;
-  
-  //  This holds the digit to be incremented next.  It is used to generate carries when a digit
-  //  passes its maximum value.
-  register unsigned long carry_digit = 0;
-              
-  //  Start one under so first set of indices will be the minimum values.
-  indices[carry_digit]--;
- 
-  //  Loop until we have carry out of last digit
-  while (carry_digit != dimension) {
 
-    //  Get the carry digit  
-    register unsigned long index = indices[carry_digit];
-  
-    //  If this index is at its max, generate carry to next digit, and start loop over
-    if (indices[carry_digit] == (faces.size() - carry_digit)) {
-      carry_digit++;        //  Generate carry into next digit
-      continue;         //  Start loop over
-    }
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::CopyAdjacencies
+//|
+//| Purpose: This method gives this Solid, just made as a copy of solid, copies
+//|          of the corners of solid, and sets up the touching_corners and
+//|          adjacent_faces lists of its Faces to match those of solid.  The
+//|          Faces of this Solid are in the same order as those of solid.
+//|          Faces which solid removed as redundant are left out of the
+//|          adjacent_faces lists, as they would be if the copy found its own
+//|          adjacencies.
+//|
+//| Parameters: solid: the Solid this is a copy of; its adjacencies must be valid
+//|_________________________________________________________________________________
 
-    //  Loop through all indices to right of carry digit, initializing them
-    for (i = carry_digit; i >= 0; i--)
-      indices[i] = index + 1 + (carry_digit-i);
+void Solid::CopyAdjacencies(Solid& solid)
+{
 
-    //  Start carry at digit 0 again (for next time through loop)  
-    carry_digit = 0;
+  //  Copy the corners, remembering which copy goes with which corner
+  std::unordered_map<Vector *, Vector *> corner_copies;
+  corner_copies.reserve(solid.corners.size());
+  corners.reserve(solid.corners.size());
+  for (CornerList::iterator corner = solid.corners.begin(); corner != solid.corners.end(); corner++) {
+    Vector *copy = new Vector(**corner);
+    corners.push_back(copy);
+    corner_copies[*corner] = copy;
+  }
 
-    //
-    //  At this point indices contains the sort of permutation we are looking for:
-    //  it is ordered strictly descending.  We now make a list of the corresponding
-    //  faces and find their intersection.
-    //
+  for (unsigned long i = 0; i < faces.size(); i++) {
 
-    // Loop through all indices, adding corresponding Face to the list
-    for (j = 0; j < dimension; j++)
-      intersected_faces.push_back(faces[indices[j] - 1]);
+    Face *face = solid.faces[i];
 
-    //  Create a new point for the intersection  
-    Vector *point = new Vector(dimension);
+    CornerList &tcorners = faces[i]->touching_corners;
+    tcorners.reserve(face->touching_corners.size());
+    for (CornerList::iterator corner = face->touching_corners.begin(); corner != face->touching_corners.end(); corner++)
+      tcorners.push_back(corner_copies[*corner]);
 
-    //  Intersect the hyperplanes.
-    bool valid = point->IntersectHyperplanes(intersected_faces);
+    //  The row of a Face of solid is its place in the faces list
+    FaceList &afaces = faces[i]->adjacent_faces;
+    afaces.reserve(face->adjacent_faces.size());
+    for (FaceList::iterator aface = face->adjacent_faces.begin(); aface != face->adjacent_faces.end(); aface++)
+      if ((*aface)->index >= 0)
+	afaces.push_back(faces[(*aface)->index]);
 
-    // If it's valid, process this intersection
-    if (valid)
-      ProcessCorner(point, intersected_faces);
+    //  The corners and Faces of the copy are in the same places as those of solid
+    faces[i]->corner_set.Assign(face->corner_set);
+    faces[i]->adjacent_set.Assign(face->adjacent_set);
 
-    //  No intersection found-- discard point    
-    else 
-      delete(point);
+  }
 
-    //  Clear faces list for next time through the loop
-    intersected_faces.erase(intersected_faces.begin(), intersected_faces.end());
-    
-  }  // while no carry past end
-  
-  free(indices);
+  adjacencies_valid = true;
+  bounded = solid.bounded;
 
-  //  Loop through all faces
-  for (face = faces.begin(); face != faces.end(); ) {
+}  //==== Solid::CopyAdjacencies() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::FinishAdjacencies
+//|
+//| Purpose: This method is called after all the corners of this Solid have been
+//|          passed to ProcessCorner.  It removes the redundant Faces, keeps only
+//|          the adjacencies of Faces which meet in a ridge, and marks the
+//|          adjacencies valid.
+//|
+//| Parameters: corners_bounded: true if the corners describe this Solid completely
+//|_________________________________________________________________________________
+
+void Solid::FinishAdjacencies(bool corners_bounded)
+{
+
+  //  Loop through all faces, moving the real ones up over the removed ones
+  std::vector<Face *> removed_faces;
+  FaceList::iterator kept = faces.begin();
+  for (FaceList::iterator face = faces.begin(); face != faces.end(); face++) {
 
     //  If this face touches more than dimension corners, it's a real face.    
     if ((*face)->touching_corners.size() >= dimension)
-      face++;
+      *kept++ = *face;
     
-    //  It doesn't touch dimension corners, so it's a redundant face; remove it   
+    //  It doesn't touch dimension corners, so it's a redundant face; remove it.  Other
+    //  faces may still list it as adjacent until their lists are trimmed below.
     else {
-      //      delete(*face);  //  DEBUG
-      faces.erase(face);
-      face = faces.begin();
+      (*face)->index = -1;
+      removed_faces.push_back(*face);
     }
    
   } //  loop through faces
+  faces.erase(kept, faces.end());
+
+  //  Close up the rows of the removed faces
+  PackFaces();
+
+  //  Two faces are adjacent only if they meet in a ridge, which has at least dimension-1
+  //  corners.  Faces which only share a corner where more than dimension faces meet are
+  //  not, and neither are the faces just removed.
+  //  The faces have moved to new rows, so their adjacent sets are made again.
+  for (FaceList::iterator face = faces.begin(); face != faces.end(); face++) {
+
+    FaceList &afaces = (*face)->adjacent_faces;
+    (*face)->adjacent_set.Clear();
+
+    for (FaceList::iterator aface = afaces.begin(); aface != afaces.end(); ) {
+
+      if (((*aface)->index >= 0) &&
+	  ((*face)->corner_set.CountCommon((*aface)->corner_set) + 1 >= (long) dimension)) {
+	(*face)->adjacent_set.Add((*aface)->index);
+	aface++;
+      }
+      else
+	aface = afaces.erase(aface);
+
+    }
+
+  }
+
+  //  No one lists the removed faces anymore
+  for (std::vector<Face *>::iterator face = removed_faces.begin(); face != removed_faces.end(); face++)
+    delete(*face);
+
+  //  If no more than dimension faces are left, this Solid was flat and encloses nothing;
+  //  it has no corners, just as a copy made from the faces that are left would find.
+  if (faces.size() <= dimension)
+    ClearAdjacencies();
+
+  //  No more corners will be added until the adjacencies are found again, so the
+  //  cells are let go rather than kept with this Solid
+  corner_cells = CornerCells(corner_cells.get_allocator());
 
   //  Adjacencies are now valid
   adjacencies_valid = true;
+  bounded = corners_bounded;
 
-}  //==== Solid::FindAdjacencies() ====//
+}  //==== Solid::FinishAdjacencies() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::SliceAdjacencies
+//|
+//| Purpose: This method finds the corners and adjacencies of the two halves of
+//|          this Solid made by Halfspace::SliceSolid, by cutting the corners of
+//|          this Solid with the slicing hyperplane.  If that can't be done (the
+//|          adjacencies of this Solid aren't valid, or it isn't known to be
+//|          bounded), the halves are left to find their own adjacencies.
+//|
+//| Parameters: inside_solid:  the half inside the slicing halfspace
+//|             outside_solid: the half outside the slicing halfspace
+//|_________________________________________________________________________________
+
+void Solid::SliceAdjacencies(Solid& inside_solid, Solid& outside_solid)
+{
+
+  if (!adjacencies_valid || !bounded)
+    return;
+
+  inside_solid.ClearAdjacencies();
+  outside_solid.ClearAdjacencies();
+
+  if (!DoubleDescriptionEnumerator::SliceCorners(corners, inside_solid, outside_solid))
+    return;
+
+  //  Halves of a bounded Solid are bounded
+  inside_solid.FinishAdjacencies(true);
+  outside_solid.FinishAdjacencies(true);
+
+}  //==== Solid::SliceAdjacencies() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::Slice
+//|
+//| Purpose: This method makes this Solid the half of itself inside a slicing
+//|          halfspace, by adding the halfspace to its Faces.  Its other Faces are
+//|          kept as they are rather than copied.  The corners of both halves are
+//|          found by cutting the corners this Solid had before, as in
+//|          SliceAdjacencies.
+//|
+//| Parameters: face:          the slicing halfspace, to add to this Solid
+//|             outside_solid: the half outside the slicing halfspace: the Faces
+//|                            of this Solid, followed by the flipped halfspace
+//|_________________________________________________________________________________
+
+void Solid::Slice(Face *face, Solid& outside_solid)
+{
+
+  bool sliceable = adjacencies_valid && bounded;
+
+  //  Keep the corners this Solid had, to cut
+  CornerList solid_corners(std::move(corners));
+  corners.clear();
+
+  //  The silhouette was of the whole Solid
+  if (silhouette) {
+    delete(silhouette);
+    silhouette = NULL;
+  }
+
+  AddFace(face);
+  ClearAdjacencies();
+
+  if (sliceable) {
+
+    outside_solid.ClearAdjacencies();
+
+    //  Halves of a bounded Solid are bounded
+    if (DoubleDescriptionEnumerator::SliceCorners(solid_corners, *this, outside_solid)) {
+      FinishAdjacencies(true);
+      outside_solid.FinishAdjacencies(true);
+    }
+
+  }
+
+  for (CornerList::iterator corner = solid_corners.begin(); corner != solid_corners.end(); corner++)
+    delete(*corner);
+
+}  //==== Solid::Slice() ====//
 
 
 
 //|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //| Solid::ProcessCorner
 //|
-//| Purpose: This method is called when FindAllIntersections finds the intersection
+//| Purpose: This method is called when the vertex enumerator finds the intersection
 //|          of a set of Faces.  This checks to see if the intersection is really a
 //|          corner of this Solid, and if it is it adds it to the Solid's corners
 //|          list and updates the touching_corners and adjacent_faces Lists of the
@@ -471,16 +917,50 @@ void Solid::ProcessCorner(Vector *corner, std::vector<Face *>& contributing_face
 
   //  If this point is not in the intersection of all the faces of this Solid, it is
   //    not a corner, and we should delete it and ignore it.
-  if (!corner->InsideOrOnHalfspaces(*((std::vector<Halfspace *> *) &faces))) {
+  if (!PointInsideOrOn(*corner)) {
     delete(corner);
     return;
   } 
 
+  AddCorner(corner, contributing_faces);
+
+}  //==== Solid::ProcessCorner ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::AddCorner
+//|
+//| Purpose: This method adds a corner which is known to be inside this Solid to
+//|          the Solid's corners list, and updates the touching_corners and
+//|          adjacent_faces Lists of the contributing Faces.  ProcessCorner calls
+//|          this once it has checked the corner; enumerators which check corners
+//|          on other threads call it directly.
+//|
+//| Parameters: corner:             the corner
+//|             contributing_faces: the Faces whose intersection is corner
+//|_________________________________________________________________________________
+
+void Solid::AddCorner(Vector *corner, std::vector<Face *>& contributing_faces)
+{
+
   // if (corners.Contains(corner))
   // corners.AppendUnique(corner, CompareCornersRoughly); //  Add this corner to this Solid's corners list
 
+  //  Where more than dimension Faces meet, the same corner is found for several sets of
+  //  them.  If we already have this corner, the contributing Faces are added to it.
+  long corner_index = FindCorner(*corner);
+  if (corner_index >= 0) {
+    delete(corner);
+    corner = corners[corner_index];
+  }
+
   //  Add this corner to this Solid's corners list
-  corners.push_back(corner);
+  else {
+    corner_index = corners.size();
+    corners.push_back(corner);
+    corner_cells.insert(std::make_pair(CornerCell(*corner, 0), corner_index));
+  }
 
   //  Loop through all contributing Faces
   for (std::vector<Face *>::iterator face = contributing_faces.begin(); face != contributing_faces.end(); face++) {
@@ -493,8 +973,11 @@ void Solid::ProcessCorner(Vector *corner, std::vector<Face *>& contributing_face
     //    AppendUnique(corner, CompareCornersRoughly);
     //               //  for this Face, if it's not already there.
 
-    //  Add this corner to the touching_corner list for this face
-    (*face)->touching_corners.push_back(corner);
+    //  Add this corner to the touching_corner list for this face, if it's not already there
+    if (!(*face)->corner_set.Contains(corner_index)) {
+      (*face)->touching_corners.push_back(corner);
+      (*face)->corner_set.Add(corner_index);
+    }
 
     // Loop through all contributing faces
     for (std::vector<Face *>::iterator aface = contributing_faces.begin(); aface != contributing_faces.end(); aface++) {
@@ -503,12 +986,10 @@ void Solid::ProcessCorner(Vector *corner, std::vector<Face *>& contributing_face
       if (face != aface) {
  
 	//  Add this Face to the adjacent_faces list for this Face, if it's not already there.
-	std::vector<Face *>::iterator findi = (*face)->adjacent_faces.begin();
-	for ( ; findi != (*face)->adjacent_faces.end(); findi++)
-	  if (*findi == *aface)
-	    break;
-	if (findi == (*face)->adjacent_faces.end())
+	if (!(*face)->adjacent_set.Contains((*aface)->index)) {
 	  (*face)->adjacent_faces.push_back(*aface);
+	  (*face)->adjacent_set.Add((*aface)->index);
+	}
  
       }  // if i != j
   
@@ -517,22 +998,114 @@ void Solid::ProcessCorner(Vector *corner, std::vector<Face *>& contributing_face
   }  //  end for i
 
 
-}  //==== Solid::ProcessCorner ====//
+}  //==== Solid::AddCorner ====//
 
 
 
 //|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-//| Procedure ComparePointers
-//|
-//| Purpose: This procedure compares two pointers to see if they are equal.  If
-//|          they are, it returns 0.  This is used as a callback for PtrList::Compare,
-//|          as used in Solid::ProcessCorner.
-//|
-//| Parameters: pointer1: a pointer
-//|             pointer2: another pointer
+//| Solid::CornerCell
+//|
+//| Purpose: This method finds the hash of a cell of the grid corners are hashed
+//|          into.  The cells are 4*VERY_SMALL_NUM wide, so a point within
+//|          VERY_SMALL_NUM of a corner in every coordinate is either in the
+//|          corner's cell or, in each coordinate where the corner is within
+//|          VERY_SMALL_NUM of the edge of its cell, in the next cell on that side.
+//|
+//| Parameters: corner:    the corner
+//|             neighbors: for each coordinate whose bit is set, use the next cell
+//|                        on the nearer side rather than the corner's own cell
+//|             returns the hash of the cell
 //|_________________________________________________________________________________
 
-int ComparePointers(const void *pointer1, const void *pointer2)
+unsigned long Solid::CornerCell(const Vector& corner, unsigned long neighbors) const
+{
+
+  unsigned long hash = 14695981039346656037UL;
+  for (unsigned long k = 0; k < dimension; k++) {
+
+    double position = corner.coordinates[k] / (4*VERY_SMALL_NUM);
+    double cell = floor(position);
+    if ((neighbors >> k) & 1)
+      cell += (position - cell < 0.5) ? -1 : 1;
+
+    hash = (hash ^ (unsigned long) (long) cell) * 1099511628211UL;
+
+  }
+
+  return hash;
+
+}  //==== Solid::CornerCell ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::FindCorner
+//|
+//| Purpose: This method looks for a corner already found while finding
+//|          adjacencies which is within VERY_SMALL_NUM of a point in every
+//|          coordinate.  The point's own cell is looked in, and the neighboring
+//|          cells across each edge it is within VERY_SMALL_NUM of, in every
+//|          combination.  A point near the edges in m coordinates costs 2^m
+//|          lookups; that is 2^n at worst, but one for most points.
+//|
+//| Parameters: corner: the point
+//|             returns the place of the corner in the corners list, or -1 if
+//|             there is none
+//|_________________________________________________________________________________
+
+long Solid::FindCorner(const Vector& corner) const
+{
+
+  //  Find the coordinates in which the point is near the edge of its cell
+  unsigned long near_edges = 0;
+  for (unsigned long k = 0; k < dimension; k++) {
+    double position = corner.coordinates[k] / (4*VERY_SMALL_NUM);
+    double offset = position - floor(position);
+    if ((offset < 0.25) || (offset > 0.75))
+      near_edges |= 1UL << k;
+  }
+
+  //  Look in the cell of the point and the neighboring cells across those edges
+  unsigned long neighbors = 0;
+  do {
+
+    std::pair<CornerCells::const_iterator, CornerCells::const_iterator> range =
+      corner_cells.equal_range(CornerCell(corner, neighbors));
+    for (CornerCells::const_iterator cell = range.first; cell != range.second; cell++) {
+
+      const Vector *other = corners[cell->second];
+      unsigned long k;
+      for (k = 0; k < dimension; k++)
+	if (fabs(other->coordinates[k] - corner.coordinates[k]) > VERY_SMALL_NUM)
+	  break;
+      if (k == dimension)
+	return cell->second;
+
+    }
+
+    //  Go on to the next combination of those edges
+    neighbors = (neighbors - near_edges) & near_edges;
+
+  } while (neighbors != 0);
+
+  return -1;
+
+}  //==== Solid::FindCorner ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Procedure ComparePointers
+//|
+//| Purpose: This procedure compares two pointers to see if they are equal.  If
+//|          they are, it returns 0.  This is used as a callback for PtrList::Compare,
+//|          as used in Solid::ProcessCorner.
+//|
+//| Parameters: pointer1: a pointer
+//|             pointer2: another pointer
+//|_________________________________________________________________________________
+
+int ComparePointers(const void *pointer1, const void *pointer2)
 {
 
   return ((long) pointer2) - ((long) pointer1);
@@ -575,15 +1148,15 @@ int CompareCornersRoughly(const void *corner1, const void *corner2)
 {
 
   //  Quick access to coordinates
-  register double *coords1 = ((Vector *) corner1)->coordinates;
-  register double *coords2 = ((Vector *) corner2)->coordinates;
+  double *coords1 = ((Vector *) corner1)->coordinates;
+  double *coords2 = ((Vector *) corner2)->coordinates;
 
   //  Loop through all coordinates
-  register long num_coords = ((Vector *) corner1)->Dimension();
-  register long i;
+  long num_coords = ((Vector *) corner1)->Dimension();
+  long i;
   for (i = 0; i < num_coords; i++) {
     
-    register double difference = coords1[i] - coords2[i];
+    double difference = coords1[i] - coords2[i];
 
     //  Found different coordinates; not equal    
     if ((difference > VERY_SMALL_NUM) || (difference < -VERY_SMALL_NUM))
@@ -654,38 +1227,33 @@ void Solid::Project(std::vector<Solid *>& projected_solids, std::vector<Light>&
   //
   
 
+  EnsureOrientation();
+
+  //  Create Vector to hold normalized normal
+  Vector normalized_normal(dimension);
+
   //  Loop through all faces of this Solid
-  for (std::vector<Face *>::iterator face = faces.begin(); face != faces.end(); face++) {
+  for (FaceList::iterator face = faces.begin(); face != faces.end(); face++) {
     
-    //  Construct the projection of this face
-    Solid *projection = new Solid(dimension-1);
-
     //  Get this face
     Face *this_face = *face;
   
     //  If the normal vector points downward, this face is pointing away from
     //    the projection hyperplane and can be ignore (backface culling).
-    if (this_face->coordinates[dimension-1] <= 0) {
-      delete(projection);
+    if (!FrontFace(this_face))
       continue;
-    }
 
-    //  Create Vector to hold normalized normal
-    Vector normalized_normal(dimension);
-    
-    //  Copy all coordinates of the normal
-    register unsigned long i;
-    for(i = 0; i < dimension; i++)
-      normalized_normal.coordinates[i] = this_face->coordinates[i];
- 
-    //  Normalize face normal
-    normalized_normal.Normalize();
+    //  Construct the projection of this face
+    Solid *projection = new Solid(dimension-1);
+
+    //  Get the normalized face normal
+    GetUnitNormal(this_face, normalized_normal);
 
     //  Add all lights' contributions to intensity
     double lights_red = ambient.red;
     double lights_green = ambient.green;
     double lights_blue = ambient.blue;
-    register unsigned long k;
+    unsigned long k;
     for (std::vector<Light>::iterator light = lights.begin(); light != lights.end(); light++)
       (*light).Apply(normalized_normal, lights_red, lights_green, lights_blue);
     
@@ -693,7 +1261,7 @@ void Solid::Project(std::vector<Solid *>& projected_solids, std::vector<Light>&
     projection->SetColor(color.red * lights_red, color.green * lights_green, color.blue * lights_blue);
 
     //  Loop through all adjacent faces
-    for (std::vector<Face *>::iterator aface = this_face->adjacent_faces.begin();
+    for (FaceList::iterator aface = this_face->adjacent_faces.begin();
 	 aface != this_face->adjacent_faces.end();
 	 aface++) {
       
@@ -720,47 +1288,27 @@ void Solid::Project(std::vector<Solid *>& projected_solids, std::vector<Light>&
       //  Now we find a corner which is on this_face but not on the adjacent face
       //
    
-      //  Loop through all corners which touch this_face
-      bool corner_found = false;
-      std::vector<Vector *>::iterator corner = this_face->touching_corners.begin();
-      for (; corner != this_face->touching_corners.end(); corner++) {
+      //  Find the first corner which touches this_face but not the adjacent face
+      long corner_index = this_face->corner_set.FirstNotIn((*aface)->corner_set);
+      bool corner_found = (corner_index >= 0);
+      if (corner_found) {
 
-	if (corner_found)
-	  break;
- 
-	//  Check if this corner also touches the adjacent face    
-	std::vector<Vector *> &tcorners = (*aface)->touching_corners;
-	std::vector<Vector *>::iterator tc;
-	for (tc = tcorners.begin(); tc != tcorners.end(); tc++)
-	  if (*tc == *corner)
-	    break;
-	if (tc == tcorners.end()) {
-
-	  // We found an acceptable corner    
-	  corner_found = true;
-	  //	  break;
-
-	  //  Temporarily knock this corner down a dimension.  This is the same as
-	  //    discarding the last coordinate, which just projects it onto the
-	  //    projection hyperplane.
-	  (*corner)->dimension--;
+	Vector *corner = corners[corner_index];
+
+	//  Temporarily knock this corner down a dimension.  This is the same as
+	//    discarding the last coordinate, which just projects it onto the
+	//    projection hyperplane.
+	corner->dimension--;
    
-	  //  Check if the projected corner is inside the projection face
-	  //  If to, negate this equation (flip the normal)
-	  if (!(*corner)->InsideHalfspace(*((Halfspace *) projection_face)))
-	    projection_face->Negate();     
+	//  Check if the projected corner is inside the projection face
+	//  If to, negate this equation (flip the normal)
+	if (!corner->InsideHalfspace(*((Halfspace *) projection_face)))
+	  projection_face->Negate();     
 
-	  //  Restore the corner to its proper dimension
-	  (*corner)->dimension++;
+	//  Restore the corner to its proper dimension
+	corner->dimension++;
    
-	}  // if also touches adjacent face
-     
-	//  This corner didn't work; look at next
-	//	else {
-	//	  k++;
-	//	}
-    
-      } //  end while (!corner_found)
+      }  // if corner found
 
       //      if (corner != this_face->touching_corners.end())
 	
@@ -770,255 +1318,684 @@ void Solid::Project(std::vector<Solid *>& projected_solids, std::vector<Light>&
       else
 	delete(projection_face);
 
-    } //  end for aface
-    
-    //  Add this face's projection to the list
-    projected_solids.push_back(projection);
-  
-  } //  end for face
+    } //  end for aface
+    
+    //  Add this face's projection to the list
+    projected_solids.push_back(projection);
+  
+  } //  end for face
+
+}  //==== Solid::Project() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::EnsureSilhouette
+//|
+//| Purpose: This method ensures that silhouette is valid for this Solid.
+//|          if it is not, it recomputes it.
+//|
+//| Parameters: none
+//|_________________________________________________________________________________
+
+void Solid::EnsureSilhouette(void) {
+
+  if (!silhouette)
+    FindSilhouette();
+
+}  //==== EnsureSilhouette() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::FindSilhouette
+//|
+//| Purpose: This method finds the silhouette of the projection of this Solid
+//|          onto the x1x2...x(n-1) hyperplane (the hyperplane where the xn
+//|          coordinate is 0).  The silhouette is an (n-1)-dimensional object on
+//|          the x1x2...x(n-1) hyperplane.  This method creates creates an
+//|          n-dimensional object which is the extrusion of the silhouette in
+//|          the xn direction.  For instance, if the silhouette were a square,
+//|          this would create an infinitly long square tunnel perpendicular to
+//|          the x1x2...x(n-1) hyperplane.
+//|
+//| Parameters: none.
+//|_________________________________________________________________________________
+
+void Solid::FindSilhouette(void) {
+
+  //  VERIFY(this);
+
+  Debug("FindSilhouette: this=" << this << "; dimension=" << dimension << std::endl);
+
+  //  Get rid of any silhouette which exists
+  if (silhouette) {
+    Debug("deleting Solid: " << silhouette << std::endl);
+    delete(silhouette);
+  }
+
+  //  Create the silhouette Solid
+  silhouette = new(Solid)(dimension);
+ 
+  //
+  //  This method is similar to Solid::Project, but it ignores all projected
+  //  edges except those that are between a front face and a back face.  All such
+  //  edges are faces of the silhouette, and are added to the silhouette Solid.
+  //
+
+  EnsureAdjacencies();
+  EnsureOrientation();
+
+  //  Loop through all faces of this Solid
+  for (FaceList::iterator face = faces.begin(); face != faces.end(); face++) {
+
+    Face *this_face = *face;
+
+    //  Only consider backfaces
+    if (FrontFace(this_face))
+      continue;
+    
+    //  Loop through all adjacent faces
+    for (FaceList::iterator aface = this_face->adjacent_faces.begin();
+	 aface != this_face->adjacent_faces.end();
+	 aface++) {
+   
+      //  Only consider frontfaces
+      if (!FrontFace(*aface))
+	continue;
+      
+      //  Create a face for the projection of the intersection of this_face with adjacent_face.
+      Face *projection_face = new Face(dimension);
+
+      //  Compute repeated terms
+      double an = this_face->coordinates[dimension-1];
+      double bn = (*aface)->coordinates[dimension-1];
+   
+      //  Compute projection of intersection
+      unsigned long k;
+      for (k = 0; k <= dimension-2; k++)
+	projection_face->coordinates[k] = bn*this_face->coordinates[k] - an*(*aface)->coordinates[k];
+   
+      //  Make the last term 0.  This means that any xn will
+      //   satisfy the equation, so it extrudes the 
+      //   silhouette in the xn direction.
+      projection_face->coordinates[k++] = 0.0;
+
+      //  Compute the constant      
+      projection_face->coordinates[k] =
+	bn*this_face->coordinates[dimension] - an*(*aface)->coordinates[dimension];
+
+      //
+      //  We have the equation of this face of the projection, up to a sign.
+      //  Now we find a corner which is on this_face but not on the adjacent face
+      //
+   
+      //  Find the first corner which touches this_face but not the adjacent face
+      long corner_index = this_face->corner_set.FirstNotIn((*aface)->corner_set);
+      bool corner_found = (corner_index >= 0);
+
+      //  Check if the projected corner is inside the projection face;
+      // if so, negate this equation (flip the normal)
+      if (corner_found && !corners[corner_index]->InsideOrOnHalfspace(*((Halfspace *) projection_face)))
+	projection_face->Negate();
+      
+      //  If every corner of this_face touches the adjacent face too, they don't meet in an
+      //  edge, and there is nothing to add
+      if (!corner_found) {
+	delete(projection_face);
+	continue;
+      }
+
+      //  Add a face to the silhouette
+      silhouette->AddFace(projection_face);
+      
+    } //  end for j
+    
+  } //  end for i
+
+  //  Many ridges can project onto the same edge of the silhouette; keep only the
+  //  faces which bound it
+  silhouette->RemoveRedundantFaces();
+  
+}  //==== Solid::FindSilhouette() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::GetSilhouette
+//|
+//| Purpose: This method returns the silhouette of this Solid.  You must call
+//|          FindSilhouette before calling this method.
+//|
+//| Parameters: returns a pointer to the silhouette.
+//|_________________________________________________________________________________
+
+Solid *Solid::GetSilhouette(void)
+{
+
+  //  ASSERT(silhouette != NULL);
+  return silhouette;
+
+} //==== Solid::GetSilhouette() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::GetBounds
+//|
+//| Purpose: This method returns the box around the corners of this Solid: the
+//|          smallest coordinates of the corners, followed by the largest.  The
+//|          first n-1 of each bound the silhouette, and the last gives the extent
+//|          along the view axis.  The box is kept until the corners change.
+//|
+//| Parameters: returns dimension minima and dimension maxima, or NULL if this
+//|             Solid is unbounded
+//|_________________________________________________________________________________
+
+const double *Solid::GetBounds(void)
+{
+
+  EnsureAdjacencies();
+
+  if (!bounded)
+    return NULL;
+
+  if (!bounds_valid) {
+
+    bounds.assign(dimension, DBL_MAX);
+    bounds.resize(2 * dimension, -DBL_MAX);
+
+    for (CornerList::iterator corner = corners.begin(); corner != corners.end(); corner++)
+      for (unsigned long k = 0; k < dimension; k++) {
+	double coordinate = (*corner)->coordinates[k];
+	if (coordinate < bounds[k])
+	  bounds[k] = coordinate;
+	if (coordinate > bounds[dimension + k])
+	  bounds[dimension + k] = coordinate;
+      }
+
+    bounds_valid = true;
+
+  }
+
+  return bounds.data();
+
+} //==== Solid::GetBounds() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::EnsureOrientation
+//|
+//| Purpose: This method finds which Faces of this Solid face the viewer, looking
+//|          along xn, and the unit normals of all its Faces, unless they are
+//|          already known.  They are kept until the Faces change.
+//|
+//| Parameters: none
+//|_________________________________________________________________________________
+
+void Solid::EnsureOrientation(void)
+{
+
+  if (orientation_valid)
+    return;
+
+  front_faces.Clear();
+  unit_normals.resize(faces.size() * dimension);
+
+  for (unsigned long i = 0; i < faces.size(); i++) {
+
+    const double *coefficients = faces[i]->coordinates;
+
+    //  A frontface points toward the x1x2...x(n-1) hyperplane
+    if (coefficients[dimension-1] > 0)
+      front_faces.Add(i);
+
+    double length = 0;
+    unsigned long k;
+    for (k = 0; k < dimension; k++)
+      length += coefficients[k] * coefficients[k];
+    length = sqrt(length);
+
+    double *normal = &unit_normals[i * dimension];
+    for (k = 0; k < dimension; k++)
+      normal[k] = coefficients[k] / length;
+
+  }
+
+  orientation_valid = true;
+
+} //==== Solid::EnsureOrientation() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::FrontFace
+//|
+//| Purpose: This method returns true if a Face of this Solid faces the viewer.
+//|          EnsureOrientation must have been called since the Faces changed.
+//|
+//| Parameters: face: the Face, one of the faces of this Solid
+//|_________________________________________________________________________________
+
+bool Solid::FrontFace(const Face *face) const
+{
+
+  return front_faces.Contains(face->index);
+
+} //==== Solid::FrontFace() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::GetUnitNormal
+//|
+//| Purpose: This method returns the normal of a Face of this Solid, scaled to unit
+//|          length.  EnsureOrientation must have been called since the Faces
+//|          changed.
+//|
+//| Parameters: face:   the Face, one of the faces of this Solid
+//|             normal: receives the unit normal; its dimension is that of this
+//|                     Solid
+//|_________________________________________________________________________________
+
+void Solid::GetUnitNormal(const Face *face, Vector& normal) const
+{
+
+  memmove(normal.coordinates, &unit_normals[face->index * dimension], dimension * sizeof(double));
+
+} //==== Solid::GetUnitNormal() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::Translate
+//|
+//| Purpose: This method translates a solid through n-space.
+//|
+//| Parameters: offset: the vector indicating the direction and distance to 
+//|                     translate this halfspace.
+//|_________________________________________________________________________________
+
+void Solid::Translate(Vector& offset)
+{
+
+  // Translate all faces
+  for (FaceList::iterator face = faces.begin(); face != faces.end(); face++)
+    (*face)->Translate(offset);
+
+  // The same Faces still meet at the same corners, which move with them
+  for (CornerList::iterator corner = corners.begin(); corner != corners.end(); corner++)
+    for (unsigned long k = 0; k < dimension; k++)
+      (*corner)->coordinates[k] += offset.coordinates[k];
+
+  // The silhouette moves with this Solid
+  if (silhouette)
+    silhouette->Translate(offset);
+
+  bounds_valid = false;
+
+} //==== Solid::Translate() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::Transform
+//|
+//| Purpose: This method applies a matrix transformation to this Solid.
+//|
+//| Parameters: m: the matrix of the transformation to apply.
+//|_________________________________________________________________________________
+
+void Solid::Transform(const AMatrix& m)
+{
+
+  // Transform all faces
+  for (FaceList::iterator face = faces.begin(); face != faces.end(); face++)
+    (*face)->Transform(m);
+
+  // Halfspace::Transform maps normals by m itself, which moves the Faces the same way as
+  // the points of this Solid only if m keeps angles.  Then the same Faces still meet at the
+  // same corners, which move with them; otherwise the corners must be found again.
+  if (adjacencies_valid && m.IsConformal()) {
+    for (CornerList::iterator corner = corners.begin(); corner != corners.end(); corner++)
+      **corner = m * (**corner);
+  }
+  else
+    adjacencies_valid = false;
+
+  bounds_valid = false;
+  orientation_valid = false;
+
+  // The silhouette is seen along xn, which m may have turned
+  if (silhouette) {
+    delete(silhouette);
+    silhouette = NULL;
+  }
+
+} //==== Solid::Transform() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::AddFace
+//|
+//| Purpose: This method adds another face to the definition of this solid.
+//|
+//| Parameters: face: the Face to add
+//|_________________________________________________________________________________
+
+void Solid::AddFace(Face *face) {
 
-}  //==== Solid::Project() ====//
+  faces.push_back(face);
+  AttachFace(face);
+
+  adjacencies_valid = false;
+
+} //==== Solid::AddHalfspace() ====//
 
 
 
 //|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-//| Solid::EnsureSilhouette
+//| Solid::InitFaceMatrix
 //|
-//| Purpose: This method ensures that silhouette is valid for this Solid.
-//|          if it is not, it recomputes it.
+//| Purpose: This method sets up an empty face matrix for a new Solid, and picks
+//|          the kernels for its dimension.
 //|
 //| Parameters: none
 //|_________________________________________________________________________________
 
-void Solid::EnsureSilhouette(void) {
+void Solid::InitFaceMatrix(void)
+{
 
-  if (!silhouette)
-    FindSilhouette();
+  face_matrix = NULL;
+  face_stride = (dimension + 1 + 3) & ~3L;
+  face_capacity = 0;
 
-}  //==== EnsureSilhouette() ====//
+  kernels = GetDimensionKernels(dimension);
+
+} //==== Solid::InitFaceMatrix() ====//
 
 
 
 //|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-//| Solid::FindSilhouette
+//| Solid::ReserveFaces
 //|
-//| Purpose: This method finds the silhouette of the projection of this Solid
-//|          onto the x1x2...x(n-1) hyperplane (the hyperplane where the xn
-//|          coordinate is 0).  The silhouette is an (n-1)-dimensional object on
-//|          the x1x2...x(n-1) hyperplane.  This method creates creates an
-//|          n-dimensional object which is the extrusion of the silhouette in
-//|          the xn direction.  For instance, if the silhouette were a square,
-//|          this would create an infinitly long square tunnel perpendicular to
-//|          the x1x2...x(n-1) hyperplane.
+//| Purpose: This method makes sure the face matrix has room for count rows.  If
+//|          it has to be moved, the Faces already in it are pointed at their new
+//|          rows.
 //|
-//| Parameters: none.
+//| Parameters: count: the number of rows needed
 //|_________________________________________________________________________________
 
-void Solid::FindSilhouette(void) {
+void Solid::ReserveFaces(long count)
+{
 
-  //  VERIFY(this);
+  if (count <= face_capacity)
+    return;
 
-  Debug("FindSilhouette: this=" << this << "; dimension=" << dimension << std::endl);
+  double *new_matrix;
+  int error = posix_memalign((void **) &new_matrix, 32, count * face_stride * sizeof(double));
+  ASSERT(error == 0);
 
-  //  Get rid of any silhouette which exists
-  if (silhouette) {
-    Debug("deleting Solid: " << silhouette << std::endl);
-    delete(silhouette);
-  }
+  for (unsigned long i = 0; i < faces.size(); i++)
+    if (faces[i]->index >= 0) {
+      memmove(new_matrix + i*face_stride, faces[i]->coordinates, face_stride * sizeof(double));
+      faces[i]->coordinates = new_matrix + i*face_stride;
+    }
 
-  //  Create the silhouette Solid
-  silhouette = new(Solid)(dimension);
- 
-  //
-  //  This method is similar to Solid::Project, but it ignores all projected
-  //  edges except those that are between a front face and a back face.  All such
-  //  edges are faces of the silhouette, and are added to the silhouette Solid.
-  //
+  free(face_matrix);
+  face_matrix = new_matrix;
+  face_capacity = count;
 
-  EnsureAdjacencies();
+} //==== Solid::ReserveFaces() ====//
 
-  //  Loop through all faces of this Solid
-  for (std::vector<Face *>::iterator face = faces.begin(); face != faces.end(); face++) {
 
-    Face *this_face = *face;
 
-    //  Only consider backfaces
-    if (this_face->coordinates[dimension-1] > 0)
-      continue;
-    
-    //  Loop through all adjacent faces
-    for (std::vector<Face *>::iterator aface = this_face->adjacent_faces.begin();
-	 aface != this_face->adjacent_faces.end();
-	 aface++) {
-   
-      //  Only consider frontfaces
-      if ((*aface)->coordinates[dimension-1] <= 0)
-	continue;
-      
-      //  Create a face for the projection of the intersection of this_face with adjacent_face.
-      Face *projection_face = new Face(dimension);
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::AttachFace
+//|
+//| Purpose: This method moves the coefficients of a Face which has just been added
+//|          to the end of the faces list into a new row of the face matrix, and
+//|          points the Face at that row.  If the matrix has to grow, all the Faces
+//|          are pointed at their new rows.
+//|
+//| Parameters: face: the Face; the last in the faces list
+//|_________________________________________________________________________________
 
-      //  Compute repeated terms
-      double an = this_face->coordinates[dimension-1];
-      double bn = (*aface)->coordinates[dimension-1];
-   
-      //  Compute projection of intersection
-      register unsigned long k;
-      for (k = 0; k <= dimension-2; k++)
-	projection_face->coordinates[k] = bn*this_face->coordinates[k] - an*(*aface)->coordinates[k];
-   
-      //  Make the last term 0.  This means that any xn will
-      //   satisfy the equation, so it extrudes the 
-      //   silhouette in the xn direction.
-      projection_face->coordinates[k++] = 0.0;
+void Solid::AttachFace(Face *face)
+{
 
-      //  Compute the constant      
-      projection_face->coordinates[k] =
-	bn*this_face->coordinates[dimension] - an*(*aface)->coordinates[dimension];
+  long row = faces.size() - 1;
 
-      //
-      //  We have the equation of this face of the projection, up to a sign.
-      //  Now we find a corner which is on this_face but not on the adjacent face
-      //
-   
-      //  Loop through all corners which touch this_face
-      bool corner_found = false;
-      k = 1;
-      while (!corner_found) {
- 
-	Vector *corner = (Vector *) this_face->touching_corners[k-1];
-    
-	//  Check if this corner also touches the adjacent face
-	std::vector<Vector *> &tcorners = (*aface)->touching_corners;
-	std::vector<Vector *>::iterator tc;
-	for (tc = tcorners.begin(); tc != tcorners.end(); tc++)
-	  if (*tc == corner)
-	    break;
-	if (tc == tcorners.end()) {
-	  //	if (!(*aface)->touching_corners.Contains(corner)) {
-
-	  // We found an acceptable corner    
-	  corner_found = true;
-
-	  //  Check if the projected corner is inside the projection face;
-	  // if so, negate this equation (flip the normal)
-	  if (!corner->InsideOrOnHalfspace(*((Halfspace *) projection_face)))
-	    projection_face->Negate();
-     
-	}  // if corner touches adjacent face
-  
-	//  This corner didn't work; look at next   
-	else
-	  k++;
- 
-      } //  end while (!corner_found)
-      
-      //  Add a face to the silhouette
-      silhouette->AddFace(projection_face);
-      
-    } //  end for j
-    
-  } //  end for i
-  
-}  //==== Solid::FindSilhouette() ====//
+  //  Make room for another row
+  if (row >= face_capacity)
+    ReserveFaces((face_capacity > 0) ? 2*face_capacity : 8);
+
+  //  Copy the coefficients into the row, and zero the padding
+  double *coefficients = face_matrix + row*face_stride;
+  memmove(coefficients, face->coordinates, (dimension + 1) * sizeof(double));
+  for (long k = dimension + 1; k < face_stride; k++)
+    coefficients[k] = 0.0;
+
+  //  Use the row from now on
+  face->FreeCoordinates();
+  face->coordinates = coefficients;
+  face->shared_coordinates = true;
+  face->index = row;
+
+  orientation_valid = false;
+
+} //==== Solid::AttachFace() ====//
 
 
 
 //|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-//| Solid::GetSilhouette
+//| Solid::PackFaces
 //|
-//| Purpose: This method returns the silhouette of this Solid.  You must call
-//|          FindSilhouette before calling this method.
+//| Purpose: This method moves the rows of the face matrix back into the order of
+//|          the faces list after Faces have been removed from it.
 //|
-//| Parameters: returns a pointer to the silhouette.
+//| Parameters: none
 //|_________________________________________________________________________________
 
-Solid *Solid::GetSilhouette(void)
+void Solid::PackFaces(void)
 {
 
-  //  ASSERT(silhouette != NULL);
-  return silhouette;
+  //  Faces only ever move to earlier rows, so this never overwrites a row still to be moved
+  for (unsigned long i = 0; i < faces.size(); i++) {
+    double *row = face_matrix + i*face_stride;
+    if (faces[i]->coordinates != row) {
+      memmove(row, faces[i]->coordinates, face_stride * sizeof(double));
+      faces[i]->coordinates = row;
+    }
+    faces[i]->index = i;
+  }
 
-} //==== Solid::GetSilhouette() ====//
+  orientation_valid = false;
+
+} //==== Solid::PackFaces() ====//
 
 
 
 //|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-//| Solid::Translate
+//| Solid::PointInside
 //|
-//| Purpose: This method translates a solid through n-space.
+//| Purpose: This method returns true if point is inside all the Faces of this
+//|          Solid.  Points which lie on or very close to a Face are considered
+//|          to be outside.  This runs straight down the face matrix.
 //|
-//| Parameters: offset: the vector indicating the direction and distance to 
-//|                     translate this halfspace.
+//| Parameters: point: the point to check
+//|             returns true if point is inside this Solid
 //|_________________________________________________________________________________
 
-void Solid::Translate(Vector& offset)
+bool Solid::PointInside(const Vector& point) const
 {
 
-  // Translate all faces
-  for (std::vector<Face *>::iterator face = faces.begin(); face != faces.end(); face++)
-    (*face)->Translate(offset);
+  return kernels->rows_above(dimension, face_matrix, face_stride, faces.size(), point.coordinates,
+			     VERY_SMALL_NUM);
 
-  adjacencies_valid = false;
+} //==== Solid::PointInside() ====//
 
-} //==== Solid::Translate() ====//
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::PointInsideOrOn
+//|
+//| Purpose: This method returns true if point is inside or on all the Faces of
+//|          this Solid.  This runs straight down the face matrix.
+//|
+//| Parameters: point: the point to check
+//|             returns true if point is inside or on this Solid
+//|_________________________________________________________________________________
+
+bool Solid::PointInsideOrOn(const Vector& point) const
+{
+
+  return kernels->rows_above(dimension, face_matrix, face_stride, faces.size(), point.coordinates,
+			     -VERY_SMALL_NUM);
+
+} //==== Solid::PointInsideOrOn() ====//
 
 
 
 //|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-//| Solid::Transform
+//| Solid::IsEmpty
 //|
-//| Purpose: This method applies a matrix transformation to this Solid.
+//| Purpose: This method returns true if this is an empty solid (if the intersection
+//|          of the half-spaces has no interior).  If the corners of this Solid
+//|          are known, it is empty if it has too few of them to enclose anything.
+//|          Otherwise a linear program finds the point deepest inside all the
+//|          faces; this Solid is empty if that point is no more than
+//|          VERY_SMALL_NUM inside them.
 //|
-//| Parameters: m: the matrix of the transformation to apply.
+//| Parameters: none
 //|_________________________________________________________________________________
 
-void Solid::Transform(const AMatrix& m)
+bool Solid::IsEmpty(void)
 {
 
-  // Transform all faces
-  for (std::vector<Face *>::iterator face = faces.begin(); face != faces.end(); face++)
-    (*face)->Transform(m);
+  //  The corners tell right away, if there are corners all around
+  if (adjacencies_valid && bounded)
+    return (corners.size() <= dimension);
+
+  //  The linear program is over the point x and its depth t inside the faces, so each
+  //  face a.x + k >= 0 with |a| = 1 becomes a.x - t + k >= 0.
+  long num_faces = faces.size();
+  long stride = dimension + 2;
+  unsigned long k;
+  std::vector<double> rows(num_faces * stride);
+  long num_rows = 0;
+  for (FaceList::iterator face = faces.begin(); face != faces.end(); face++) {
+
+    const double *coordinates = (*face)->coordinates;
+    double length = 0;
+    for (k = 0; k < dimension; k++)
+      length += coordinates[k] * coordinates[k];
+    length = sqrt(length);
+
+    //  A face with no normal holds everywhere or nowhere
+    if (length <= VERY_SMALL_NUM) {
+      if (coordinates[dimension] < -VERY_SMALL_NUM)
+	return true;
+      continue;
+    }
 
-  adjacencies_valid = false;
+    double *row = &rows[stride * num_rows++];
+    for (k = 0; k < dimension; k++)
+      row[k] = coordinates[k] / length;
+    row[dimension] = -1;
+    row[dimension + 1] = coordinates[dimension] / length;
 
-} //==== Solid::Transform() ====//
+  }
+
+  //  Maximize t
+  std::vector<double> objective(dimension + 2, 0.0);
+  objective[dimension] = -1;
+  std::vector<double> solution(dimension + 1);
+  if (!MinimizeOverHalfspaces(dimension + 1, rows.data(), num_rows, objective.data(),
+			      BOUNDING_BOX_SIZE, solution.data()))
+    return true;
+
+  return (solution[dimension] <= VERY_SMALL_NUM);
+
+} //==== Solid::IsEmpty() ====//
 
 
 
 //|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-//| Solid::AddFace
+//| Solid::ClassifyCorners
 //|
-//| Purpose: This method adds another face to the definition of this solid.
+//| Purpose: This method finds which side of a halfspace this Solid is on, from
+//|          its corners.  It returns INSIDE if no corner is more than
+//|          VERY_SMALL_NUM outside halfspace (this includes a Solid with too few
+//|          corners to enclose anything), OUTSIDE if no corner is more than
+//|          VERY_SMALL_NUM inside it, and STRADDLING otherwise, or if the corners
+//|          are not known all around this Solid.
 //|
-//| Parameters: face: the Face to add
+//| Parameters: halfspace: the halfspace to classify this Solid against
+//|             returns INSIDE, OUTSIDE or STRADDLING
 //|_________________________________________________________________________________
 
-void Solid::AddFace(Face *face) {
+int Solid::ClassifyCorners(const Halfspace& halfspace) const
+{
 
-  faces.push_back(face);
+  if (!adjacencies_valid || !bounded)
+    return STRADDLING;
 
-  adjacencies_valid = false;
+  if (corners.size() <= dimension)
+    return INSIDE;
 
-} //==== Solid::AddHalfspace() ====//
+  bool any_inside = false;
+  bool any_outside = false;
+  for (CornerList::const_iterator corner = corners.begin(); corner != corners.end(); corner++) {
+
+    double value = kernels->evaluate(dimension, halfspace.coordinates, (*corner)->coordinates);
+    if (value > VERY_SMALL_NUM)
+      any_inside = true;
+    else if (value < -VERY_SMALL_NUM)
+      any_outside = true;
+
+    if (any_inside && any_outside)
+      return STRADDLING;
+
+  }
+
+  return (any_outside ? OUTSIDE : INSIDE);
+
+} //==== Solid::ClassifyCorners() ====//
 
 
 
 //|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-//| Solid::IsEmpty
+//| Solid::OutsideSomeFace
 //|
-//| Purpose: This method returns true if this is an empty solid (if the intersection
-//|          of the half-spaces is empty).
+//| Purpose: This method returns true if some face of solid has no corner of this
+//|          Solid more than VERY_SMALL_NUM inside it, so that no corner of this
+//|          Solid is inside solid.  For a silhouette, the face separates the
+//|          silhouettes of the two Solids.
 //|
-//| Parameters: none
+//| Parameters: solid: the Solid whose faces to check
 //|_________________________________________________________________________________
 
-bool Solid::IsEmpty(void)
+bool Solid::OutsideSomeFace(const Solid& solid) const
 {
 
+  for (FaceList::const_iterator face = solid.faces.begin(); face != solid.faces.end(); face++) {
+
+    CornerList::const_iterator corner;
+    for (corner = corners.begin(); corner != corners.end(); corner++)
+      if (kernels->evaluate(dimension, (*face)->coordinates, (*corner)->coordinates) > VERY_SMALL_NUM)
+	break;
+
+    if (corner == corners.end())
+      return true;
+
+  }
+
   return false;
 
-} //==== Solid::IsEmpty() ====//
+} //==== Solid::OutsideSomeFace() ====//
 
 
 
@@ -1040,6 +2017,55 @@ int Solid::OrderSolids(Solid& solid)
   solid.EnsureSilhouette();
   EnsureAdjacencies();
   solid.EnsureAdjacencies();
+  EnsureOrientation();
+  solid.EnsureOrientation();
+
+  //
+  //  First the quick tests.  If the boxes around the silhouettes don't meet, or one
+  //  Solid is outside a face of the silhouette of the other, the silhouettes are
+  //  disjoint.  Otherwise, if one Solid is wholly nearer along xn than the other
+  //  and a point inside it is inside the silhouette of the other, it is in front.
+  //
+
+  const double *bounds = GetBounds();
+  const double *solid_bounds = solid.GetBounds();
+  if (bounds && solid_bounds) {
+
+    unsigned long k;
+    for (k = 0; k < dimension - 1; k++)
+      if ((bounds[k] > solid_bounds[dimension + k] + VERY_SMALL_NUM) ||
+	  (solid_bounds[k] > bounds[dimension + k] + VERY_SMALL_NUM)) {
+	order_stats.box_separated++;
+	return NEITHER;
+      }
+
+    if (OutsideSomeFace(*solid.silhouette) || solid.OutsideSomeFace(*silhouette)) {
+      order_stats.face_separated++;
+      return NEITHER;
+    }
+
+    bool nearer = (bounds[2*dimension - 1] < solid_bounds[dimension - 1] - VERY_SMALL_NUM);
+    bool farther = (solid_bounds[2*dimension - 1] < bounds[dimension - 1] - VERY_SMALL_NUM);
+    if ((nearer || farther) && (corners.size() > 0)) {
+
+      //  The center of this Solid is inside it
+      Vector center(dimension);
+      for (k = 0; k < dimension; k++)
+	center.coordinates[k] = 0;
+      for (CornerList::iterator corner = corners.begin(); corner != corners.end(); corner++)
+	for (k = 0; k < dimension; k++)
+	  center.coordinates[k] += (*corner)->coordinates[k] / corners.size();
+
+      if (solid.silhouette->PointInside(center)) {
+	order_stats.depth_ordered++;
+	return (nearer ? INFRONT : BEHIND);
+      }
+
+    }
+
+  }
+
+  order_stats.corner_tested++;
  
   //
   //  Here we check all the corners of this Solid.  If any corner is inside the silhouette of solid,
@@ -1048,19 +2074,19 @@ int Solid::OrderSolids(Solid& solid)
   //
   
   //  Loop through all corners in this Solid
-  std::vector<Vector *>::iterator corner;
+  CornerList::iterator corner;
   for (corner = corners.begin(); corner != corners.end(); corner++) {
   
     //  Check if this corner is in the silhouette of solid; if not, check next corner
-    if (!(*corner)->InsideHalfspaces(*((std::vector<Halfspace *> *) &(solid.silhouette->faces))))
+    if (!solid.silhouette->PointInside(**corner))
       continue;
   
     //  Loop through all faces of solid
-    for (std::vector<Face *>::iterator face = solid.faces.begin(); face != solid.faces.end(); face++) {
+    for (FaceList::iterator face = solid.faces.begin(); face != solid.faces.end(); face++) {
   
       //  If this is a backface, and if corner is behind it,
       //   then this Solid must be behind solid      
-      if ((*face)->coordinates[dimension-1] <= 0) {
+      if (!solid.FrontFace(*face)) {
 	if (!(*corner)->InsideHalfspace(**face))
 	  return BEHIND;      
       }
@@ -1087,14 +2113,14 @@ int Solid::OrderSolids(Solid& solid)
   for (corner = solid.corners.begin(); corner != solid.corners.end(); corner++) {
     
     //  If this corner is not in silhouette of this Solid, check next corner
-    if (!(*corner)->InsideHalfspaces(*((std::vector<Halfspace *> *) &(silhouette->faces))))
+    if (!silhouette->PointInside(**corner))
 	continue;
     
     //  Loop through all faces of this Solid
-    for (std::vector<Face *>::iterator face = faces.begin(); face != faces.end(); face++) {
+    for (FaceList::iterator face = faces.begin(); face != faces.end(); face++) {
   
       //  If this is a backface, and if corner is behind it, then solid must be behind this Solid
-      if ((*face)->coordinates[dimension-1] <= 0)
+      if (!FrontFace(*face))
 	{
 	  if (!(*corner)->InsideHalfspace(**face))
 	    return INFRONT;
@@ -1132,9 +2158,9 @@ void Solid::Duplicate(Solid& copy)
   copy.dimension = dimension;
 
   //  Copy the faces and corners
-  for (std::vector<Face *>::iterator face = copy.faces.begin(); face != copy.faces.end(); face++)
+  for (FaceList::iterator face = copy.faces.begin(); face != copy.faces.end(); face++)
     AddFace(new Face(**face));
-  for (std::vector<Vector *>::iterator corner = copy.corners.begin(); corner != copy.corners.end(); corner++)
+  for (CornerList::iterator corner = copy.corners.begin(); corner != copy.corners.end(); corner++)
     corners.push_back(new Vector(**corner));
 
   adjacencies_valid = false;
@@ -1148,48 +2174,187 @@ void Solid::Duplicate(Solid& copy)
 //|
 //| Purpose: This method creates a list of Solids which together form the difference
 //|          of solid from this Solid.  The difference contains everything that
-//|          is in this Solid, but not in solid.
+//|          is in this Solid, but not in solid.  Empty pieces are left out, and
+//|          this Solid is only sliced along the faces of solid which cut it.
 //|
 //| Parameters: solid:      the Solid to subtract from the Solid
 //|             difference: receives difference (a collection of Solids)
 //|_________________________________________________________________________________
 
-void Solid::Subtract(Solid& solid, std::vector<Solid *>& difference)
+void Solid::Subtract(Solid& solid, SolidList& difference)
 {
 
-  //  Make a copy of this Solid
-  register Solid *remainingSolid = new Solid(*this);
+  //  What remains of this Solid after the slices so far.  The first slice leaves this
+  //  Solid alone; later ones slice what remains in place, so its Faces are kept
+  //  from one slice to the next rather than copied each time.
+  std::unique_ptr<Solid> remaining;
 
   //  difference.Append(remainingSolid);
   //  return;
 
   //  Loop through all faces of solid
-  for (std::vector<Face *>::iterator face = solid.faces.begin(); face != solid.faces.end(); face++) {
+  for (FaceList::iterator face = solid.faces.begin(); face != solid.faces.end(); face++) {
   
     Solid *insideSolid;
     Solid *outsideSolid;
+
+    //  See which side of this face what remains of this Solid is on
+    Solid& remainder = remaining ? *remaining : *this;
+    remainder.EnsureAdjacencies();
+    int side = remainder.ClassifyCorners(**face);
+
+    //  If none of it is outside this face, slicing would only make an empty piece
+    if (side == INSIDE)
+      continue;
+
+    //  If all of it is outside this face, all of it is part of the difference, and
+    //  nothing is left to be outside the later faces
+    if (side == OUTSIDE) {
+      if (remaining)
+	difference.push_back(std::move(remaining));
+      else
+	difference.push_back(std::unique_ptr<Solid>(new Solid(*this)));
+      break;
+    }
   
     //  Slice what remains of this Solid along this face
-    (*face)->SliceSolid(*remainingSolid, insideSolid, outsideSolid);
+    if (!remaining) {
+      (*face)->SliceSolid(*this, insideSolid, outsideSolid);
+      remaining.reset(insideSolid);
+    }
+    else
+      (*face)->SliceSolid(*remaining, outsideSolid);
   
     //  The section of the solid which is outside this face is part of the difference (since it is
-    //   outside solid).
-    difference.push_back(outsideSolid);
-  
-    //  We don't need the solid we just sliced anymore
-    delete(remainingSolid);
-  
-    //  Save what was inside this face to be sliced by other faces.      
-    remainingSolid = insideSolid;
+    //   outside solid), unless there is nothing there.
+    if (outsideSolid->IsEmpty())
+      delete(outsideSolid);
+    else
+      difference.push_back(std::unique_ptr<Solid>(outsideSolid));
 
+    //  If nothing remains, nothing more can be outside the later faces
+    if (remaining->IsEmpty())
+      break;
+  
   }  // faces
 
-  delete(remainingSolid);
+  //  The last slice is deleted now that we don't need it anymore
 
 } //==== Solid::Subtract() ====//
 
 
 
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| SameHyperplane
+//|
+//| Purpose: This procedure returns true if two halfspaces have the same bounding
+//|          hyperplane, facing the same way (sign 1) or opposite ways (sign -1).
+//|
+//| Parameters: dimension: the dimension of the halfspaces
+//|             a, b:      the coefficients of the halfspaces
+//|             sign:      1 or -1
+//|_________________________________________________________________________________
+
+static bool SameHyperplane(long dimension, const double *a, const double *b, double sign)
+{
+
+  double a_length = 0;
+  double b_length = 0;
+  long k;
+  for (k = 0; k < dimension; k++) {
+    a_length += a[k] * a[k];
+    b_length += b[k] * b[k];
+  }
+  a_length = sqrt(a_length);
+  b_length = sqrt(b_length);
+
+  if ((a_length <= VERY_SMALL_NUM) || (b_length <= VERY_SMALL_NUM))
+    return false;
+
+  for (k = 0; k <= dimension; k++)
+    if (fabs(a[k] / a_length - sign * b[k] / b_length) > VERY_SMALL_NUM)
+      return false;
+
+  return true;
+
+} //==== SameHyperplane() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Solid::Merge
+//|
+//| Purpose: This method makes a Solid which is the union of this Solid and solid,
+//|          if they lie on opposite sides of a face they share and the union is
+//|          convex.  That is so when every corner of each is inside every other
+//|          face of the other; the union is then the intersection of those other
+//|          faces.  This is how the pieces made by Subtract fit together.  The
+//|          union has the color of this Solid; its corners are found when needed.
+//|
+//| Parameters: solid:   the Solid to merge with this Solid
+//|             returns the union, or NULL if it can't be made this way
+//|_________________________________________________________________________________
+
+Solid *Solid::Merge(Solid& solid)
+{
+
+  EnsureAdjacencies();
+  solid.EnsureAdjacencies();
+
+  //  Find the face of this Solid which solid has facing the other way
+  FaceList::iterator shared_face;
+  FaceList::iterator other_face;
+  for (shared_face = faces.begin(); shared_face != faces.end(); shared_face++) {
+    for (other_face = solid.faces.begin(); other_face != solid.faces.end(); other_face++)
+      if (SameHyperplane(dimension, (*shared_face)->coordinates, (*other_face)->coordinates, -1))
+	break;
+    if (other_face != solid.faces.end())
+      break;
+  }
+  if (shared_face == faces.end())
+    return NULL;
+
+  //  Each must be inside all the other faces of the other
+  FaceList::iterator face;
+  for (face = faces.begin(); face != faces.end(); face++)
+    if ((face != shared_face) && (solid.ClassifyCorners(**face) != INSIDE))
+      return NULL;
+
+  for (face = solid.faces.begin(); face != solid.faces.end(); face++)
+    if ((face != other_face) && (ClassifyCorners(**face) != INSIDE))
+      return NULL;
+
+  //  The union is inside the other faces of both, and no others
+  Solid *merged = new Solid(dimension);
+  merged->SetColor(color);
+  merged->ReserveFaces(faces.size() + solid.faces.size() - 2);
+
+  for (face = faces.begin(); face != faces.end(); face++)
+    if (face != shared_face)
+      merged->AddFace(new Face(**face));
+
+  for (face = solid.faces.begin(); face != solid.faces.end(); face++) {
+
+    if (face == other_face)
+      continue;
+
+    //  A face both have is only needed once
+    FaceList::iterator same_face;
+    for (same_face = faces.begin(); same_face != faces.end(); same_face++)
+      if (SameHyperplane(dimension, (*same_face)->coordinates, (*face)->coordinates, 1))
+	break;
+
+    if (same_face == faces.end())
+      merged->AddFace(new Face(**face));
+
+  }
+
+  return merged;
+
+} //==== Solid::Merge() ====//
+
+
+
 //|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //| Solid::ScanConvert
 //|
@@ -1215,7 +2380,7 @@ void Solid::ScanConvert(Voxel *voxel_array, long *minimum, long *maximum)
   double *point_coords = point->coordinates;
  
   //  Set point to minimum in all dimensions
-  register unsigned long i;
+  unsigned long i;
   for (i = 0; i < dimension; i++)
     point_coords[i] = minimum[i];
   
@@ -1242,7 +2407,7 @@ void Solid::ScanConvert(Voxel *voxel_array, long *minimum, long *maximum)
     
     //  If we're inside the solid, mark it the color of
     //    this solid.
-    if (point->InsideOrOnHalfspaces(*((std::vector<Halfspace *> *) &faces)))
+    if (PointInsideOrOn(*point))
       *voxel_array_element = color;
   
     //  Go to next voxel array element
@@ -1357,6 +2522,7 @@ void Solid::DrawUsingOpenGL3D(std::vector<Light>& lights, const Color &ambient,
   //  EnsureAdjacencies();
   ASSERT(adjacencies_valid);
   ASSERT(dimension == 3);
+  EnsureOrientation();
 
   //  Create Vector to hold normalized normal
   Vector normalized_normal(3);
@@ -1364,7 +2530,7 @@ void Solid::DrawUsingOpenGL3D(std::vector<Light>& lights, const Color &ambient,
   // Draw all faces
   std::vector<Vector *> vertices;
   int i = 0;
-  for (std::vector<Face *>::iterator face = faces.begin(); face != faces.end(); face++) {
+  for (FaceList::iterator face = faces.begin(); face != faces.end(); face++) {
 
     i++;
 
@@ -1375,13 +2541,8 @@ void Solid::DrawUsingOpenGL3D(std::vector<Light>& lights, const Color &ambient,
     //      continue;
     //    }
 
-    //  Copy all coordinates of the normal
-    normalized_normal.coordinates[0] = (*face)->coordinates[0];
-    normalized_normal.coordinates[1] = (*face)->coordinates[1];
-    normalized_normal.coordinates[2] = (*face)->coordinates[2];
- 
-    //  Normalize face normal
-    normalized_normal.Normalize();
+    //  Get the normalized face normal
+    GetUnitNormal(*face, normalized_normal);
 
     //  Add all lights' contributions to intensity
     double lights_red = ambient.red;
@@ -1407,7 +2568,7 @@ void Solid::DrawUsingOpenGL3D(std::vector<Light>& lights, const Color &ambient,
     p2 = (*face)->touching_corners[1];
     polygonNormal3D = *face;
     p1p2 = new Vector(*p2 - *p1);
-    std::vector<Vector *>::iterator corner = (*face)->touching_corners.begin();
+    CornerList::iterator corner = (*face)->touching_corners.begin();
     corner++;
     for (; corner != (*face)->touching_corners.end(); corner++)
       vertices.push_back(*corner);
@@ -1511,8 +2672,8 @@ void Solid::DrawUsingOpenGL2D(bool outline, bool fill)
   std::vector<Vector *> right_side;
  
   // Get top and bottom points of polygon
-  std::vector<Vector *>::iterator topCorner = (std::vector<Vector *>::iterator) corners.begin();
-  std::vector<Vector *>::iterator bottomCorner = (std::vector<Vector *>::iterator) corners.end();
+  CornerList::iterator topCorner = corners.begin();
+  CornerList::iterator bottomCorner = corners.end();
   bottomCorner--;
 
   // Both sides start with the top point
@@ -1526,7 +2687,7 @@ void Solid::DrawUsingOpenGL2D(bool outline, bool fill)
   double *bottom_point_coords = (*bottomCorner)->coordinates;
  
   // Loop through all points except top and bottom, in top-to-bottom order
-  std::vector<Vector *>::iterator corner = topCorner;
+  CornerList::iterator corner = topCorner;
   corner++;
   for (; corner != bottomCorner; corner++) {
   
@@ -1634,7 +2795,7 @@ void GLPoint2D(const Vector &p) {
 bool LeftSide(double start_h, double start_v, double end_h, double end_v, double point_h, double point_v)
 {
   
-  register double dot_product = (end_v - start_v) * (point_h - start_h) + (start_h - end_h) * (point_v - start_v);
+  double dot_product = (end_v - start_v) * (point_h - start_h) + (start_h - end_h) * (point_v - start_v);
   
   return (dot_product < 0);
 
@@ -1829,7 +2990,7 @@ void Solid::DrawPolygonFilled(Bitmap& bitmap)
   double *topPointCoords = topPoint->coordinates;   //  Get pointer to top point coordinates
   double *bottomPointCoords = bottomPoint->coordinates; //  Get pointer to bottom point coordinates
  
-  register long i;
+  long i;
   for (i = 2; i < corners.NumElements(); i++)    //  Loop through all points except top and bottom,
     //    in top-to-bottom order
     {
@@ -1856,8 +3017,8 @@ void Solid::DrawPolygonFilled(Bitmap& bitmap)
   rightSide.Append(bottomPoint);
  
 
-  register long currentScanline = topPointCoords[1];  //  Start scanning at the top
-  register char *currentScanlineBase = (char *)
+  long currentScanline = topPointCoords[1];  //  Start scanning at the top
+  char *currentScanlineBase = (char *)
     (bitmap.rows[bitmap.bounds.bottom - currentScanline]
      - bitmap.bounds.left);  //  Find base address in Bitmap of top line
 
@@ -1899,11 +3060,11 @@ void Solid::DrawPolygonFilled(Bitmap& bitmap)
   //   coordinates) as the coordinates of the start of
   //   the new segments, as desired.
 
-  register double currentLeft = topPointCoords[0];  //  Start the left scanner at the top point's x
-  register double currentRight = topPointCoords[0];  //  Start the right scanner at the top point's x
+  double currentLeft = topPointCoords[0];  //  Start the left scanner at the top point's x
+  double currentRight = topPointCoords[0];  //  Start the right scanner at the top point's x
  
-  register double leftIncrement;
-  register double rightIncrement;       //  Amount of change for currentLeft and
+  double leftIncrement;
+  double rightIncrement;       //  Amount of change for currentLeft and
   //   currentRight per scanline step.  These will
   //   be initialized inside the loop
 
@@ -1922,7 +3083,7 @@ void Solid::DrawPolygonFilled(Bitmap& bitmap)
       for(; currentScanline > nextVertexScanline;
 	  currentScanline--)      //  Loop through all scanlines until next vertex
 	{
-	  register Pixel *currentPixel =
+	  Pixel *currentPixel =
 	    (Pixel *) currentScanlineBase;
 	  currentPixel += (int) currentLeft;    //  Point to leftmost pixel of this scanline
 
@@ -8,14 +8,47 @@
 #ifndef HSOLID
 #define HSOLID
 
+#include "arena.h"
 #include "color.h"
+#include "indexset.h"
 #include "light.h"
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 
 class AMatrix;
+class DimensionKernels;
 class Face;
+class Halfspace;
 class Vector;
+class Solid;
+class VertexEnumerator;
+
+
+//  A list of Solids which owns them
+typedef std::vector<std::unique_ptr<Solid> > SolidList;
+
+
+//
+//  Counts of the ways OrderSolids has decided the order of two Solids since the
+//  counts were cleared: by the boxes around their silhouettes, by a face of one
+//  silhouette which the other is outside, by their extents along the view axis,
+//  or by testing their corners against each other's faces.
+//
+
+class OrderStats
+{
+
+public:
+
+  unsigned long box_separated;
+  unsigned long face_separated;
+  unsigned long depth_ordered;
+  unsigned long corner_tested;
+
+};
+
 
 class Solid
 {
@@ -26,9 +59,65 @@ private:
 
   Solid *silhouette;
 
-  std::vector<Face *> faces;
-  std::vector<Vector *> corners;
+  FaceList faces;
+  CornerList corners;
+
+  //  The coefficients of the Faces, one row per Face in the order of faces.  Each
+  //  row is padded to face_stride doubles (a multiple of four), the matrix is
+  //  aligned on 32 bytes, and the coordinates of each Face point at its row.
+  double *face_matrix;
+  long face_stride;
+  long face_capacity;
+
+  //  The inner loops compiled for this dimension
+  const DimensionKernels *kernels;
+
   bool adjacencies_valid;
+
+  //  true if the corners describe this Solid completely (it is bounded)
+  bool bounded;
+
+  //  The smallest and largest coordinates of the corners: the box around the
+  //  silhouette, then the extent along the view axis (xn).  bounds holds the
+  //  minima followed by the maxima.
+  std::pmr::vector<double> bounds;
+  bool bounds_valid;
+
+  //  Which Faces face the viewer (their xn coefficient is positive), by their
+  //  places in faces, and the normals of the Faces scaled to unit length, dimension
+  //  doubles per Face.  These are kept until the Faces change.
+  IndexSet front_faces;
+  std::pmr::vector<double> unit_normals;
+  bool orientation_valid;
+
+  //  The corners found so far while finding adjacencies, by a hash of the cell of
+  //  the grid they are in, so corners found more than once are only added once.
+  //  This is only filled while corners are being added, and is made in the frame's
+  //  arena like the rest of the frame's geometry.
+  typedef std::pmr::unordered_multimap<unsigned long, long> CornerCells;
+  CornerCells corner_cells;
+
+  //  The engine FindAdjacencies uses to find corners
+  static VertexEnumerator *vertex_enumerator;
+
+  void ClearAdjacencies(void);
+  void CopyAdjacencies(Solid& solid);
+  void FinishAdjacencies(bool corners_bounded);
+  unsigned long CornerCell(const Vector& corner, unsigned long neighbors) const;
+  long FindCorner(const Vector& corner) const;
+  bool OutsideSomeFace(const Solid& solid) const;
+
+  void EnsureOrientation(void);
+  bool FrontFace(const Face *face) const;
+  void GetUnitNormal(const Face *face, Vector& normal) const;
+
+  //  How OrderSolids has decided
+  static OrderStats order_stats;
+
+  void InitFaceMatrix(void);
+  void ReserveFaces(long count);
+  void AttachFace(Face *face);
+  void PackFaces(void);
    
 protected:
   
@@ -37,10 +126,21 @@ protected:
 public:
   
   Solid(long dimension);
-  Solid(Solid &solid);
+  Solid(Solid &solid, bool copy_adjacencies = true);
+  Solid(Solid &&solid);
   ~Solid(void);
 
-  const std::vector<Vector *> &Corners(void) const;
+  static void *operator new(size_t size);
+  static void operator delete(void *object);
+
+  long Dimension(void) const { return dimension; }
+  const DimensionKernels *Kernels(void) const { return kernels; }
+  const FaceList &Faces(void) const;
+  const CornerList &Corners(void) const;
+
+  static void SetVertexEnumerator(int which);
+  static void ClearOrderStats(void);
+  static void GetOrderStats(OrderStats& stats);
 
   void SetColor(double red, double green, double blue);
   void SetColor(Color& new_color);
@@ -50,23 +150,32 @@ public:
   void DumpAdjacencies(void);
   void DumpFaces(void);
   void FindAdjacencies(void);
+  void RemoveRedundantFaces(void);
   void EnsureAdjacencies(void);
+  void SliceAdjacencies(Solid& inside_solid, Solid& outside_solid);
+  void Slice(Face *face, Solid& outside_solid);
 
   //  void FindAllIntersections(vector<Face *>& intersected_faces, short first_available, short num_needed, long dimension);
 
   void ProcessCorner(Vector *corner, std::vector<Face *>& contributing_faces);
+  void AddCorner(Vector *corner, std::vector<Face *>& contributing_faces);
   
   void Project(std::vector<Solid *>& projected_solids, std::vector<Light>& lights, const Color &ambient);
   void Translate(Vector& offset);
   void Transform(const AMatrix& m);
   void AddFace(Face *face);
+  bool PointInside(const Vector& point) const;
+  bool PointInsideOrOn(const Vector& point) const;
   bool IsEmpty(void);
+  int ClassifyCorners(const Halfspace& halfspace) const;
   int OrderSolids(Solid& solid);
   void Duplicate(Solid& copy);
-  void Subtract(Solid& solid, std::vector<Solid *>& difference);
+  void Subtract(Solid& solid, SolidList& difference);
+  Solid *Merge(Solid& solid);
   
   void FindSilhouette(void);
   Solid *GetSilhouette(void);
+  const double *GetBounds(void);
   void EnsureSilhouette(void);
 
   void ScanConvert(Color *voxel_array, long *minima, long *maxima);
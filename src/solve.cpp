@@ -75,7 +75,7 @@ enum {
   many_solutions
 };
 
-long SolveEquations(register long n, register Equation *AB, register double *X)
+long SolveEquations(long n, Equation *AB, double *X)
 {
 
   //
@@ -89,7 +89,7 @@ long SolveEquations(register long n, register Equation *AB, register double *X)
   //
   
   //  Loop through each row except last
-  register long i, j, k, max;
+  long i, j, k, max;
   for (i = 0; i <= n-2; i++) {
     
     //  Assume this row has largest pivot
@@ -101,7 +101,7 @@ long SolveEquations(register long n, register Equation *AB, register double *X)
 	max = j;						
     
     //  Swap row i with largest pivot row
-    register Equation temp;
+    Equation temp;
     temp = AB[i];
     AB[i] = AB[max];
     AB[max] = temp;
@@ -130,7 +130,7 @@ long SolveEquations(register long n, register Equation *AB, register double *X)
       return many_solutions;
     
     //  Compute sum of all variables and coefficients
-    register double sum = 0.0;
+    double sum = 0.0;
     for (k = j+1; k <= n-1; k++)
       sum += AB[j][k]*X[k];
 		
@@ -6,6 +6,10 @@
 //|_______________________________________________________________________________________
 
 
+#ifndef HSOLVE
+#define HSOLVE
+
+
 #include "adsoda_types.h"
 
 //#define VERY_SMALL_NUM	1E-15
@@ -24,8 +28,18 @@
 typedef double *Equation;			
 
 
+//
+//  Callers which solve small systems keep them on the stack, in arrays of
+//  SOLVE_MAX_DIMENSION equations; larger systems are allocated.
+//
+
+#define SOLVE_MAX_DIMENSION	8
+
+
 //======================= Prototypes ==========================//
 
 long SolveEquations(long n, Equation *ABMATRIX, double *X);
 
+#endif
+
 
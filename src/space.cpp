@@ -13,15 +13,60 @@
 #include "debug.h"
 
 #include "solve.h"
+#include "threadpool.h"
 
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
+#include <utility>
 
 
 //==== PROTOTYPES
 
 void clearBackground(void);
 
+//  How far the pieces of hidden solid removal are merged, and how many there were
+long Space::fragment_budget = 1;
+HiddenRemovalStats Space::removal_stats = { 0, 0, 0, 0 };
+
+
+//
+//  What hidden solid removal finds for one Solid: the pieces it is clipped into,
+//  before and after merging, and whether it was clipped at all.
+//
+
+class ClipResult
+{
+
+public:
+
+  SolidList pieces;
+  unsigned long fragments_made;
+  bool clipped;
+
+  ClipResult(void) { fragments_made = 0; clipped = false; }
+
+};
+
+
+//
+//  The work of clipping the Solids of one level of the occlusion graph, one task
+//  per Solid.  None of them is in front of another, and the Solids in front of
+//  them are only read, so the tasks can be done on different threads.
+//
+
+class ClipJob
+{
+
+public:
+
+  SolidList *sources;
+  std::vector<std::vector<long> > *occluders;
+  std::vector<ClipResult> *results;
+  std::vector<long> level;
+
+};
+
 
 
 //|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -59,8 +104,8 @@ Space::Space(Space& space)
   dimension = space.dimension;
 
   // Duplicate all Solids, and add them to the copy
-  for (std::vector<Solid *>::iterator solid = space.solids.begin(); solid != space.solids.end(); solid++)
-    solids.push_back(new Solid(**solid));
+  for (SolidList::iterator solid = space.solids.begin(); solid != space.solids.end(); solid++)
+    solids.push_back(std::unique_ptr<Solid>(new Solid(**solid)));
 
   // Duplicate all Lights, and add them to the copy
   for (std::vector<Light>::iterator light = space.lights.begin(); light != space.lights.end(); light++)
@@ -72,6 +117,28 @@ Space::Space(Space& space)
 
 
 
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Space::Space
+//|
+//| Purpose: This method creates a Space which takes over the Solids and Lights
+//|          of another Space, leaving it empty.
+//|
+//| Parameters: space: Space to take the contents of
+//|_________________________________________________________________________________
+
+Space::Space(Space&& space) :
+
+  ambient(space.ambient),
+  lights(std::move(space.lights)),
+  dimension(space.dimension),
+  solids(std::move(space.solids))
+
+{
+
+} //==== Space::Space() ====//
+
+
+
 //|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //| Space::~Space
 //|
@@ -89,11 +156,7 @@ Space::~Space(void)
   //  for (i = 1; i <= lights.NumElements(); i++)
   //    delete((Light *) lights.Element(i));
 
-  // delete all Solids in the solids list
-  for (std::vector<Solid *>::iterator solid = solids.begin(); solid != solids.end(); solid++) {
-    //    delete(*solid);
-    delete(*solid);
-  }
+  // The solids list deletes all the Solids in it
 
   //  register long i;
   //  for (i = 1; i <= solids.NumElements(); i++) {
@@ -116,8 +179,8 @@ Space::~Space(void)
 void Space::AddSolid(Solid *solid)
 {
 
-  // Add this Solid to the solids list
-  solids.push_back(solid);
+  // Add this Solid to the solids list, which owns it from now on
+  solids.push_back(std::unique_ptr<Solid>(solid));
 
 } //==== Space::AddSolid() ====//
 
@@ -147,7 +210,8 @@ void Space::AddLight(Light *light)
 //|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //| Space::Clear
 //|
-//| Purpose: This method removes all Solids from this space.
+//| Purpose: This method removes all Solids from this space.  The Space owns
+//|          its Solids, so they are deleted.
 //|
 //| Parameters: none
 //|_________________________________________________________________________________
@@ -156,7 +220,7 @@ void Space::Clear(void)
 {
 
   // Remove all Solids from the list
-  //  for (std::vector<Solid *>::iterator solid = solids.begin(); solid != solids.end(); solid++)
+  //  for (SolidList::iterator solid = solids.begin(); solid != solids.end(); solid++)
   //    delete(*solid);
   solids.erase(solids.begin(), solids.end());
 
@@ -174,9 +238,6 @@ void Space::Clear(void)
 
 void Space::ClearAndDelete(void) {
 
-  for (std::vector<Solid *>::iterator solid = solids.begin(); solid != solids.end(); solid++) {
-    delete(*solid);
-  }
   solids.erase(solids.begin(), solids.end());
 
 } //==== Space::ClearAnddelete() ====//
@@ -194,24 +255,22 @@ void Space::ClearAndDelete(void) {
 void Space::EliminateEmptySolids(void) {
 
   // Loop through all Solids in this Space
-  for (std::vector<Solid *>::iterator solid = solids.begin(); solid != solids.end(); solid++) {
+  SolidList::iterator solid = solids.begin();
+  while (solid != solids.end()) {
   
     // Call EnsureAdjacencies for this Solid
     (*solid)->EnsureAdjacencies();
  
-    // Check if this is an empty Solid (no corners); if so, remove it from the list
-    // and delete it from memory
+    // Check if this is an empty Solid (no corners); if so, remove it from the list,
+    // which deletes it from memory
     if ((*solid)->Corners().size() <= dimension) {
 
       //      cout << "REMOVING EMPTY SOLID" << endl;
-      delete(*solid);
-      solids.erase(solid);
-   
-      // Start over
-      //      solid = solids.begin();
-      solid--;
+      solid = solids.erase(solid);
 
     }
+    else
+      solid++;
 
   }  // loop through all solids
        
@@ -234,35 +293,19 @@ void Space::Subtract(Solid& solid)
 {
 
   // Create a list of Solids to receive difference of solid from Solids in this Space
-  std::vector<Solid *> difference;
+  SolidList difference;
 
-  // Create a list of Solids to receive difference of solid from a single Solid
-  std::vector<Solid *> solid_difference;
- 
   //  Loop through all Solids in this Space
-  std::vector<Solid *>::iterator this_solid;
+  SolidList::iterator this_solid;
   for (this_solid = solids.begin(); this_solid != solids.end(); this_solid++) {
     
     // Subtract solid from this_solid, and put resulting Solid(s) in difference
-    (*this_solid)->Subtract(solid, solid_difference);
+    (*this_solid)->Subtract(solid, difference);
   
-    // Move all solids in the difference of solid from this_solid to the difference list
-    for (std::vector<Solid *>::iterator s = solid_difference.begin(); s != solid_difference.end(); s++)
-      difference.push_back(*s);
-
-    solid_difference.erase(solid_difference.begin(), solid_difference.end());
-
   }  // loop through solids
 
-  // Remove all Solids in this Space
-  for (this_solid = solids.begin(); this_solid != solids.end(); this_solid++)
-    delete(*this_solid);
-  Clear();
-  //  solids.erase(solids.begin(), solids.end());
- 
-  // Copy all solids in difference to this Space
-  for (std::vector<Solid *>::iterator diffi = difference.begin(); diffi != difference.end(); diffi++)
-    solids.push_back(*diffi);
+  // The difference replaces the Solids in this Space, which are deleted
+  solids.swap(difference);
 
 } //==== Space::Subtract() ====//
 
@@ -271,7 +314,7 @@ void Space::Subtract(Solid& solid)
 //|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //| Space::Add
 //|
-//| Purpose: This method adds all the solids in space to this Space.  It does not
+//| Purpose: This method moves all the solids in space to this Space.  It does not
 //|          check for overlap of Solids.
 //|
 //| Parameters: space: the space containing the solids to add
@@ -280,9 +323,10 @@ void Space::Subtract(Solid& solid)
 void Space::Add(Space& space)
 {
 
-  // Add all solids in space to this space
-  for (std::vector<Solid *>::iterator solid = space.solids.begin(); solid != space.solids.end(); solid++)
-    AddSolid(*solid);
+  // Move all solids in space to this space
+  for (SolidList::iterator solid = space.solids.begin(); solid != space.solids.end(); solid++)
+    solids.push_back(std::move(*solid));
+  space.Clear();
 
 } //==== Space::Add() ====//
 
@@ -307,7 +351,7 @@ void Space::Project(Space *projection)
   projection->ClearAndDelete();
 
   // Loop through all Solids in this Space
-  for (std::vector<Solid *>::iterator solid = solids.begin(); solid != solids.end(); solid++) {
+  for (SolidList::iterator solid = solids.begin(); solid != solids.end(); solid++) {
 
     // Create a new list for projected faces
     std::vector<Solid *> projected_faces;
@@ -331,7 +375,10 @@ void Space::Project(Space *projection)
 //|
 //| Purpose: This method removes all Solids from this Space which are not visible.
 //|          If a Solid is partially visible, the visible part remains and the
-//|          hidden part is removed.
+//|          hidden part is removed; the pieces the visible part is clipped into
+//|          are merged back together as far as fragment_budget allows.  Each
+//|          Solid is clipped against the silhouettes of the Solids in front of
+//|          it, found first for all Solids by BuildOcclusionGraph.
 //|
 //| Parameters: none
 //|_________________________________________________________________________________
@@ -339,77 +386,93 @@ void Space::Project(Space *projection)
 void Space::RemoveHiddenSolids(void)
 {
 
-  // Make a copy of this space
-  Space *sourceSpace = new Space(*this);
+  // Take the Solids out of this Space.  They are clipped where they are, rather than
+  // as copies, and must stay whole until every Solid has been clipped against them.
+  SolidList sources;
+  sources.swap(solids);
+
+  // Find which Solids are in front of which.  This also finds the adjacencies and
+  // silhouettes of all the Solids, so clipping only reads them.
+  long num_solids = sources.size();
+  std::vector<std::vector<long> > occluders(num_solids);
+  std::vector<std::vector<long> > occluded(num_solids);
+  BuildOcclusionGraph(sources, occluders, occluded);
+
+  // What remains of each Solid after its hidden parts are clipped away
+  std::vector<ClipResult> results(num_solids);
+
+  // Clip the Solids from front to back, a level at a time: a Solid is clipped once all
+  // the Solids in front of it have been.  A Solid found to be completely hidden still
+  // clips the Solids behind it: OrderSolids finds no order for some Solids whose
+  // silhouettes cross, so the Solids which hide it may not be known to hide those
+  // behind it too.  The Solids of a level are clipped on the thread pool.
+  ClipJob job;
+  job.sources = &sources;
+  job.occluders = &occluders;
+  job.results = &results;
+
+  std::vector<long> waiting(num_solids);
+  std::vector<bool> done(num_solids, false);
+  std::vector<long> ready;
+  long i;
+  for (i = 0; i < num_solids; i++) {
+    waiting[i] = occluders[i].size();
+    if (waiting[i] == 0)
+      ready.push_back(i);
+  }
 
-  // Find adjacencies for each Solid in sourceSpace
-  //  sourceSpace->EnsureAdjacencies();
- 
-  // Find the silhouettes for each Solid in sourceSpace
-  //  sourceSpace->FindSilhouettes();
-
-  // delete all Solids in this Space
-  for (std::vector<Solid *>::iterator deleteSolid = solids.begin(); deleteSolid != solids.end(); deleteSolid++)
-    delete(*deleteSolid);
-  Clear();
-
-  // Loop through all Solids in the original Space
-  for (std::vector<Solid *>::iterator sourceSpaceSolid = sourceSpace->solids.begin();
-       sourceSpaceSolid != sourceSpace->solids.end();
-       sourceSpaceSolid++) {
-  
-    // Create a space to hold what remains of this Solid after all hidden parts are clipped away.
-    Space *solidResult = new Space(dimension, ambient);
-  
-    // Get a copy of this solid
-    Solid *clippedSolid = new Solid(**sourceSpaceSolid);
-  
-    // Find adjacencies and silhouettes for this Solid
-    clippedSolid->EnsureAdjacencies();
-    clippedSolid->EnsureAdjacencies();
-    clippedSolid->EnsureSilhouette();
-  
-    // Add this solid to the clipped solid space
-    Solid *clippedSolidCopy = new Solid(*clippedSolid);
-    solidResult->AddSolid(clippedSolidCopy);
-
-    // Loop though all Solids in this Space
-    for (std::vector<Solid *>::iterator clipSolid = sourceSpace->solids.begin();
-	 clipSolid != sourceSpace->solids.end();
-	 clipSolid++) {
-   
-      // Don't clip a Solid with itself
-      if (clipSolid == sourceSpaceSolid)
-	continue;
-   
-      // Check whether the solid we're clipping is behind the solid we're clipping it to;
-      // if it's not behind, go to the next clip Solid
-      clippedSolid->EnsureSilhouette();
-      //      clippedSolid->GetSilhouette()->FindAdjacencies();
-      //      clippedSolid->GetSilhouette()->DrawUsingOpenGL2D();
-      if (clippedSolid->OrderSolids(**clipSolid) != BEHIND)
-	continue;
+  long num_done = 0;
+  while (num_done < num_solids) {
 
-      // The Solid we're clipping is begin the Solid we're clipping with; clip the Solid in back
-      // against the one in front.
-      solidResult->Subtract(*((*clipSolid)->GetSilhouette()));
+    // If every Solid left is waiting for another, some are in a cycle, each in front
+    // of the next; clip the first one left anyway, against all the Solids in front of it
+    if (ready.empty()) {
+      for (i = 0; done[i]; i++)
+	;
+      ready.push_back(i);
+    }
 
-    }  // clip all solids
-    
-    // We have finished clipping this solid; add what remains of it to this Space.
-    for (std::vector<Solid *>::iterator solidResultSolid = solidResult->solids.begin();
-	 solidResultSolid != solidResult->solids.end();
-	 solidResultSolid++) {
-      solids.push_back(new Solid(**solidResultSolid));
+    job.level.clear();
+    for (std::vector<long>::iterator solid = ready.begin(); solid != ready.end(); solid++)
+      if (!done[*solid]) {
+	done[*solid] = true;
+	job.level.push_back(*solid);
+      }
+    ready.clear();
+
+    ThreadPool::GetThreadPool()->Run(job.level.size(), ClipSolid, &job);
+
+    // The Solids behind these have fewer to wait for
+    for (std::vector<long>::iterator solid = job.level.begin(); solid != job.level.end(); solid++) {
+      num_done++;
+      for (std::vector<long>::iterator behind = occluded[*solid].begin();
+	   behind != occluded[*solid].end();
+	   behind++)
+	if ((--waiting[*behind] == 0) && !done[*behind])
+	  ready.push_back(*behind);
     }
 
-    // delete the solidResult space (but not the solids which were in it, and are now in this Space).
-    delete(solidResult);
-    delete(clippedSolid);
   }
-  
-  // delete the original copy of this Space
-  delete(sourceSpace);
+
+  // We have finished clipping; hand each Solid, or what remains of it, back to this
+  // Space, in the order of the Solids.
+  for (i = 0; i < num_solids; i++) {
+
+    ClipResult& result = results[i];
+    if (!result.clipped) {
+      solids.push_back(std::move(sources[i]));
+      removal_stats.fragments_made++;
+      removal_stats.fragments_kept++;
+      continue;
+    }
+
+    removal_stats.fragments_made += result.fragments_made;
+    removal_stats.fragments_kept += result.pieces.size();
+
+    for (SolidList::iterator piece = result.pieces.begin(); piece != result.pieces.end(); piece++)
+      solids.push_back(std::move(*piece));
+
+  }
 
   //  EnsureAdjacencies();
 
@@ -417,6 +480,305 @@ void Space::RemoveHiddenSolids(void)
 
 
 
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Space::FindOverlappingPairs
+//|
+//| Purpose: This method finds the pairs of Solids whose silhouettes may overlap,
+//|          by sweeping along x1 over the boxes around their silhouettes (see
+//|          Solid::GetBounds) and comparing the boxes which meet there in the
+//|          other silhouette coordinates.  Only these pairs need to be ordered.
+//|          Unbounded Solids may overlap any other.
+//|
+//| Parameters: sources:     the Solids
+//|             overlapping: receives, for each Solid, the indices of the Solids
+//|                          it may overlap, in increasing order
+//|_________________________________________________________________________________
+
+void Space::FindOverlappingPairs(SolidList& sources, std::vector<std::vector<long> >& overlapping)
+{
+
+  long num_solids = sources.size();
+  long i, j;
+  long k;
+
+  // Find the boxes, and sort the bounded Solids by where their boxes start along x1.
+  // A silhouette in one dimension has nothing to sweep along.
+  std::vector<const double *> bounds(num_solids);
+  std::vector<std::pair<double, long> > starts;
+  std::vector<bool> unbounded(num_solids);
+  for (i = 0; i < num_solids; i++) {
+    bounds[i] = sources[i]->GetBounds();
+    unbounded[i] = (!bounds[i] || (dimension < 2));
+    if (!unbounded[i])
+      starts.push_back(std::pair<double, long>(bounds[i][0], i));
+  }
+  std::sort(starts.begin(), starts.end());
+
+  // Sweep along x1, keeping the boxes which haven't ended yet
+  std::vector<long> active;
+  for (std::vector<std::pair<double, long> >::iterator start = starts.begin(); start != starts.end(); start++) {
+
+    i = start->second;
+
+    unsigned long kept = 0;
+    for (unsigned long a = 0; a < active.size(); a++) {
+
+      j = active[a];
+      if (bounds[j][dimension] < start->first - VERY_SMALL_NUM)
+	continue;
+      active[kept++] = j;
+
+      // These boxes meet along x1; check the rest of the silhouette coordinates
+      for (k = 1; k < dimension - 1; k++)
+	if ((bounds[i][k] > bounds[j][dimension + k] + VERY_SMALL_NUM) ||
+	    (bounds[j][k] > bounds[i][dimension + k] + VERY_SMALL_NUM))
+	  break;
+
+      if (k == dimension - 1) {
+	overlapping[i].push_back(j);
+	overlapping[j].push_back(i);
+      }
+
+    }
+    active.resize(kept);
+    active.push_back(i);
+
+  }
+
+  // Unbounded Solids may overlap anything; a pair of them is only added once
+  for (i = 0; i < num_solids; i++) {
+    if (!unbounded[i])
+      continue;
+    for (j = 0; j < num_solids; j++)
+      if ((j != i) && !(unbounded[j] && (j < i))) {
+	overlapping[i].push_back(j);
+	overlapping[j].push_back(i);
+      }
+  }
+
+  for (i = 0; i < num_solids; i++)
+    std::sort(overlapping[i].begin(), overlapping[i].end());
+
+} //==== Space::FindOverlappingPairs() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Space::BuildOcclusionGraph
+//|
+//| Purpose: This method finds which Solids are in front of which.  Each pair of
+//|          Solids whose silhouettes may overlap is ordered once, with
+//|          Solid::OrderSolids, and the order of the reverse pair follows.
+//|
+//| Parameters: sources:   the Solids
+//|             occluders: receives, for each Solid, the indices of the Solids in
+//|                        front of it, in increasing order
+//|             occluded:  receives, for each Solid, the indices of the Solids
+//|                        behind it
+//|_________________________________________________________________________________
+
+void Space::BuildOcclusionGraph(SolidList& sources, std::vector<std::vector<long> >& occluders,
+				std::vector<std::vector<long> >& occluded)
+{
+
+  long num_solids = sources.size();
+
+  // Find adjacencies and silhouettes for all Solids
+  for (SolidList::iterator solid = sources.begin(); solid != sources.end(); solid++) {
+    (*solid)->EnsureAdjacencies();
+    (*solid)->EnsureSilhouette();
+  }
+
+  // Only Solids whose silhouettes may overlap can hide each other
+  std::vector<std::vector<long> > overlapping(num_solids);
+  FindOverlappingPairs(sources, overlapping);
+
+  // Order each pair once.  The pairs are found in increasing order, so the
+  // occluders of each Solid are too.
+  unsigned long num_pairs = 0;
+  for (long i = 0; i < num_solids; i++)
+    for (std::vector<long>::iterator j = overlapping[i].begin(); j != overlapping[i].end(); j++) {
+
+      if (*j < i)
+	continue;
+      num_pairs++;
+
+      int order = sources[i]->OrderSolids(*sources[*j]);
+      if (order == BEHIND) {
+	occluders[i].push_back(*j);
+	occluded[*j].push_back(i);
+      }
+      else if (order == INFRONT) {
+	occluders[*j].push_back(i);
+	occluded[i].push_back(*j);
+      }
+
+    }
+
+  removal_stats.pairs_ordered += num_pairs;
+  removal_stats.pairs_culled += num_solids * (num_solids - 1) / 2 - num_pairs;
+
+} //==== Space::BuildOcclusionGraph() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Space::ClipSolid
+//|
+//| Purpose: This procedure clips one Solid of a level of the occlusion graph against
+//|          the silhouettes of all the Solids in front of it, and merges the pieces
+//|          left.  It is a task of a ClipJob, and only changes the ClipResult of its
+//|          own Solid.
+//|
+//| Parameters: task: the place of the Solid in the level
+//|             data: the ClipJob
+//|_________________________________________________________________________________
+
+void Space::ClipSolid(long task, void *data)
+{
+
+  ClipJob *job = (ClipJob *) data;
+  long source_index = job->level[task];
+  Solid *clippedSolid = (*job->sources)[source_index].get();
+  std::vector<long>& occluders = (*job->occluders)[source_index];
+  ClipResult& result = (*job->results)[source_index];
+  SolidList& solidResult = result.pieces;
+
+  result.clipped = false;
+
+  // Loop though the Solids in front of this one
+  for (std::vector<long>::iterator clip_index = occluders.begin(); clip_index != occluders.end(); clip_index++) {
+
+    // Clip the Solid in back against the one in front.  The first clip slices the Solid
+    // itself; later ones slice the pieces left by the clips before.
+    Solid& silhouette = *((*job->sources)[*clip_index]->GetSilhouette());
+    if (!result.clipped) {
+      clippedSolid->Subtract(silhouette, solidResult);
+      result.clipped = true;
+    }
+    else {
+      SolidList difference;
+      for (SolidList::iterator piece = solidResult.begin(); piece != solidResult.end(); piece++)
+	(*piece)->Subtract(silhouette, difference);
+      solidResult.swap(difference);
+    }
+
+  }  // clip all solids
+
+  // Put back together the pieces of this Solid which can be
+  result.fragments_made = solidResult.size();
+  if (result.clipped)
+    MergeFragments(solidResult);
+
+} //==== Space::ClipSolid() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Space::MergeFragments
+//|
+//| Purpose: This method merges pieces of the same Solid back together where their
+//|          union is convex (see Solid::Merge), until no more than fragment_budget
+//|          pieces are left or no two pieces can be merged.
+//|
+//| Parameters: fragments: the pieces; receives the merged pieces
+//|_________________________________________________________________________________
+
+void Space::MergeFragments(SolidList& fragments)
+{
+
+  if (fragment_budget <= 0)
+    return;
+
+  // A merged piece may merge with pieces it couldn't before, so keep going until
+  // nothing changes
+  bool merged_any = true;
+  while (merged_any && ((long) fragments.size() > fragment_budget)) {
+
+    merged_any = false;
+    for (unsigned long i = 0; (i < fragments.size()) && ((long) fragments.size() > fragment_budget); i++) {
+
+      unsigned long j = i + 1;
+      while ((j < fragments.size()) && ((long) fragments.size() > fragment_budget)) {
+
+	Solid *merged = fragments[i]->Merge(*fragments[j]);
+	if (merged) {
+	  fragments[i].reset(merged);
+	  fragments.erase(fragments.begin() + j);
+	  merged_any = true;
+	  j = i + 1;
+	}
+	else
+	  j++;
+
+      }
+
+    }
+
+  }
+
+} //==== Space::MergeFragments() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Space::SetFragmentBudget
+//|
+//| Purpose: This method sets how far RemoveHiddenSolids merges the pieces it
+//|          clips each Solid into.
+//|
+//| Parameters: budget: pieces of one Solid are merged until no more than this many
+//|                     are left; 0 to leave them as they are
+//|_________________________________________________________________________________
+
+void Space::SetFragmentBudget(long budget)
+{
+
+  fragment_budget = budget;
+
+} //==== Space::SetFragmentBudget() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Space::ClearHiddenRemovalStats
+//|
+//| Purpose: This method starts counting the work done by RemoveHiddenSolids over.
+//|
+//| Parameters: none
+//|_________________________________________________________________________________
+
+void Space::ClearHiddenRemovalStats(void)
+{
+
+  removal_stats.fragments_made = 0;
+  removal_stats.fragments_kept = 0;
+  removal_stats.pairs_ordered = 0;
+  removal_stats.pairs_culled = 0;
+
+} //==== Space::ClearHiddenRemovalStats() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Space::GetHiddenRemovalStats
+//|
+//| Purpose: This method returns how many pieces RemoveHiddenSolids has left since
+//|          the counts were cleared, before and after merging them, and how many
+//|          pairs of Solids it ordered and culled.
+//|
+//| Parameters: stats: receives the counts
+//|_________________________________________________________________________________
+
+void Space::GetHiddenRemovalStats(HiddenRemovalStats& stats)
+{
+
+  stats = removal_stats;
+
+} //==== Space::GetHiddenRemovalStats() ====//
+
+
+
 //|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //| Space::Transform
 //|
@@ -430,7 +792,7 @@ void Space::Transform(const AMatrix& m)
 {
 
   // Transform all solids in this space
-  for (std::vector<Solid *>::iterator solid = solids.begin(); solid != solids.end(); solid++)
+  for (SolidList::iterator solid = solids.begin(); solid != solids.end(); solid++)
     (*solid)->Transform(m);
 
 } //==== Space::Transform() ====//
@@ -454,7 +816,7 @@ void Space::DrawIntoVoxelArray(Voxel *voxel_array, long *minimum, long *maximum)
 {
 
   // Draw all solids in this space into the voxel array
-  for (std::vector<Solid *>::iterator solid = solids.begin(); solid != solids.end(); solid++)
+  for (SolidList::iterator solid = solids.begin(); solid != solids.end(); solid++)
     (*solid)->ScanConvert(voxel_array, minimum, maximum);
 
 } //==== Space::DrawIntoVoxelArray() ====//
@@ -475,7 +837,7 @@ void Space::DrawUsingOpenGL3D(bool outline, bool fill)
 {
 
   // Draw all Solids in this space
-  for (std::vector<Solid *>::iterator solid = solids.begin(); solid != solids.end(); solid++)
+  for (SolidList::iterator solid = solids.begin(); solid != solids.end(); solid++)
     (*solid)->DrawUsingOpenGL3D(lights, ambient, outline, fill);
     
 } //==== Space::DrawUsingOpenGL3D() ====//
@@ -484,7 +846,7 @@ void Space::DrawUsingOpenGL3D(bool outline, bool fill)
 void Space::EnsureAdjacencies(void) {
 
   // Draw all Solids in this space
-  for (std::vector<Solid *>::iterator solid = solids.begin(); solid != solids.end(); solid++)
+  for (SolidList::iterator solid = solids.begin(); solid != solids.end(); solid++)
     (*solid)->EnsureAdjacencies();
     
 }  //==== Space::EnsureAdjacencies() ====//
@@ -503,7 +865,7 @@ void Space::DrawUsingOpenGL2D(bool outline, bool fill)
 {
 
   // Draw all Solids in this space
-  for (std::vector<Solid *>::iterator solid = solids.begin(); solid != solids.end(); solid++)
+  for (SolidList::iterator solid = solids.begin(); solid != solids.end(); solid++)
     (*solid)->DrawUsingOpenGL2D(outline, fill);
 
 } //==== Space::DrawUsingOpenGL2D() ====//
@@ -523,7 +885,7 @@ void Space::DrawUsingOpenGL1D(bool outline, bool fill)
 {
 
   // Draw all Solids in this space
-  for (std::vector<Solid *>::iterator solid = solids.begin(); solid != solids.end(); solid++)
+  for (SolidList::iterator solid = solids.begin(); solid != solids.end(); solid++)
     (*solid)->DrawUsingOpenGL1D(outline, fill);
 
 } //==== Space::DrawUsingOpenGL1D() ====//
@@ -543,7 +905,7 @@ void Space::DrawUsingOpenGL1D(bool outline, bool fill)
 void Space::DrawOntoBitmapFilled(Bitmap& bitmap)
 {
 
- register long i;
+ long i;
  for (i = 1; i <= solids.NumElements(); i++)   //  Loop through all Solids in this Space
   ((Solid *) solids.Element(i))->
        DrawPolygonFilled(bitmap); //  Draw this polygon
@@ -565,7 +927,7 @@ void Space::DrawOntoBitmapFilled(Bitmap& bitmap)
 void Space::DrawOntoBitmapWireframe(Bitmap& bitmap)
 {
 
- register long i;
+ long i;
  for (i = 1; i <= solids.NumElements(); i++)   //  Loop through all Solids in this Space
   ((Solid *) solids.Element(i))->
       DrawPolygonWireframe(bitmap); //  Draw this polygon wireframe
@@ -587,7 +949,7 @@ void Space::DrawOntoBitmapWireframe(Bitmap& bitmap)
 void Space::DrawOntoBitmapX(Bitmap& bitmap)
 {
 
- register long i;
+ long i;
  for (i = 1; i <= solids.NumElements(); i++)   //  Loop through all Solids in this Space
   ((Solid *) solids.Element(i))->
        DrawLineSegment(bitmap); //  Draw this polygon
@@ -611,18 +973,30 @@ void Space::DrawOntoBitmapX(Bitmap& bitmap)
 
 bool Space::IntersectHyperplanes(std::vector<Hyperplane *>& hyperplanes, Vector& intersection) {
 
-  //  Allocate space for system of equations
-  Equation *system = (Equation *) malloc(dimension*sizeof(Equation));
-  ASSERT(system != NULL);
+  //  Small systems of equations are built on the stack
+  double rows[SOLVE_MAX_DIMENSION][SOLVE_MAX_DIMENSION+1];
+  Equation stack_system[SOLVE_MAX_DIMENSION];
+  Equation *system = stack_system;
+  bool small_system = (dimension <= SOLVE_MAX_DIMENSION);
 
-  int i = 1;
+  //  Otherwise allocate space for system of equations
+  if (!small_system) {
+    system = (Equation *) malloc(dimension*sizeof(Equation));
+    ASSERT(system != NULL);
+  }
+
+  int i = 0;
   for (std::vector<Hyperplane *>::iterator hyperplane = hyperplanes.begin();
        hyperplane != hyperplanes.end();
        hyperplane++) {
 
     // Allocate space for one equation
-    system[i] = (Equation) malloc((dimension+1)*sizeof(double));
-    ASSERT(system[i] != NULL);
+    if (small_system)
+      system[i] = rows[i];
+    else {
+      system[i] = (Equation) malloc((dimension+1)*sizeof(double));
+      ASSERT(system[i] != NULL);
+    }
 
     memmove(system[i], (*hyperplane)->coordinates, (dimension+1)*sizeof(double));
 
@@ -631,7 +1005,16 @@ bool Space::IntersectHyperplanes(std::vector<Hyperplane *>& hyperplanes, Vector&
   }
 
   // Solve the equations
-  return (!SolveEquations(dimension, system, intersection.coordinates));
+  bool valid = !SolveEquations(dimension, system, intersection.coordinates);
+
+  // Free the memory used by the system of equations
+  if (!small_system) {
+    for (i = 0; i < dimension; i++)
+      free(system[i]);
+    free(system);
+  }
+
+  return valid;
 
 } //==== Space::IntersectHyperplanes() ====//
 
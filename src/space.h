@@ -14,30 +14,63 @@
 #include "light.h"
 #include <vector>
 #include "halfspace.h"
+#include "solid.h"
 
 class Vector;
 class AMatrix;
+class ClipJob;
 //class Hyperplane;
 class Solid;
 class Halfspace;
 
+//
+//  Counts of the work hidden solid removal has done since the stats were cleared:
+//  the pieces it left, before and after merging, and the pairs of Solids it
+//  ordered or found could not overlap.
+//
+
+class HiddenRemovalStats
+{
+
+public:
+
+  unsigned long fragments_made;
+  unsigned long fragments_kept;
+  unsigned long pairs_ordered;
+  unsigned long pairs_culled;
+
+};
+
+
 class Space
 {
 
   Color ambient;
   std::vector<Light> lights;
   long	dimension;
+
+  //  Pieces of one Solid are merged until no more than this many are left; 0
+  //  leaves them as they are
+  static long fragment_budget;
+  static HiddenRemovalStats removal_stats;
+
+  void FindOverlappingPairs(SolidList& sources, std::vector<std::vector<long> >& overlapping);
+  void BuildOcclusionGraph(SolidList& sources, std::vector<std::vector<long> >& occluders,
+			   std::vector<std::vector<long> >& occluded);
+  static void ClipSolid(long task, void *data);
+  static void MergeFragments(SolidList& fragments);
   
 
 public:
 
-  std::vector<Solid *> solids;
+  SolidList solids;
 	
   //  The (n-1)-space associate with this Space.
   //  Space *lowerSpace;
 
   Space(long dimension, const Color &pambient);
   Space(Space& space);
+  Space(Space&& space);
   ~Space(void);
 
   long Dimension(void) { return dimension; } 
@@ -63,6 +96,10 @@ public:
   
   void RemoveHiddenSolids(void);	
 
+  static void SetFragmentBudget(long budget);
+  static void ClearHiddenRemovalStats(void);
+  static void GetHiddenRemovalStats(HiddenRemovalStats& stats);
+
   void DrawIntoVoxelArray(Voxel *voxel_array, long *minimum, long *maximum);
 
 //  void DrawOntoBitmapFilled(Bitmap& bitmap);
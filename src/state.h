@@ -25,6 +25,11 @@ typedef struct {
   bool rotate4D;
   bool demoInitialized;
   bool drawcubeFlag;
+  int vertexEnumerator;
+  int numThreads;
+  bool useArena;
+  bool printStats;
+  int fragmentBudget;
   
   double theta;
   double rho;
@@ -0,0 +1,300 @@
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| ThreadPool.cp
+//|
+//| This is the implementation of the ThreadPool class.
+//|_____________________________________________________________________________
+
+#include "threadpool.h"
+
+#include <stdlib.h>
+
+
+//  The pool used by ADSODA; created when it is first needed
+ThreadPool *ThreadPool::thread_pool = NULL;
+
+//  true on a thread while it runs a task
+static thread_local bool running_task = false;
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| ThreadPool::ThreadPool
+//|
+//| Purpose: This method creates a ThreadPool, and starts its threads.
+//|
+//| Parameters: num_threads: the number of threads to run tasks on, including the
+//|                          thread which calls Run
+//|_________________________________________________________________________________
+
+ThreadPool::ThreadPool(long num_threads)
+{
+
+  if (num_threads < 1)
+    num_threads = 1;
+
+  task = NULL;
+  task_data = NULL;
+  remaining = 0;
+  generation = 0;
+  quitting = false;
+
+  //  Queue 0 belongs to the thread which calls Run
+  for (long i = 0; i < num_threads; i++)
+    queues.push_back(new TaskQueue);
+
+  for (long i = 1; i < num_threads; i++)
+    threads.push_back(std::thread(&ThreadPool::Work, this, i));
+
+} //==== ThreadPool::ThreadPool() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| ThreadPool::~ThreadPool
+//|
+//| Purpose: This method stops the threads of a ThreadPool, and disposes of it.
+//|
+//| Parameters: none
+//|_________________________________________________________________________________
+
+ThreadPool::~ThreadPool(void)
+{
+
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    quitting = true;
+  }
+  start.notify_all();
+
+  for (std::vector<std::thread>::iterator thread = threads.begin(); thread != threads.end(); thread++)
+    thread->join();
+
+  for (std::vector<TaskQueue *>::iterator queue = queues.begin(); queue != queues.end(); queue++)
+    delete(*queue);
+
+} //==== ThreadPool::~ThreadPool() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| ThreadPool::NumThreads
+//|
+//| Purpose: This method returns the number of threads which run tasks, including
+//|          the thread which calls Run.
+//|
+//| Parameters: returns the number of threads
+//|_________________________________________________________________________________
+
+long ThreadPool::NumThreads(void) const
+{
+
+  return queues.size();
+
+} //==== ThreadPool::NumThreads() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| ThreadPool::Run
+//|
+//| Purpose: This method runs tasks 0 through num_tasks-1, and returns when they
+//|          have all finished.  The tasks may run in any order, on any thread, so
+//|          they must not depend on each other.  A task may call Run too; the
+//|          tasks it starts are run on its own thread.
+//|
+//| Parameters: num_tasks: the number of tasks
+//|             task:      the procedure to call for each task
+//|             data:      passed to each call of task
+//|_________________________________________________________________________________
+
+void ThreadPool::Run(long num_tasks, ThreadTask new_task, void *data)
+{
+
+  //  With only one thread, there's no one to share with; a task can't share either,
+  //  since the other threads may be waiting for it
+  if (threads.empty() || running_task) {
+    for (long i = 0; i < num_tasks; i++)
+      (*new_task)(i, data);
+    return;
+  }
+
+  if (num_tasks <= 0)
+    return;
+
+  {
+    std::lock_guard<std::mutex> guard(lock);
+
+    task = new_task;
+    task_data = data;
+    remaining = num_tasks;
+
+    //  Deal the tasks out to the queues in turn, so neighboring tasks start on different threads
+    for (long i = 0; i < num_tasks; i++) {
+      TaskQueue *queue = queues[i % queues.size()];
+      std::lock_guard<std::mutex> queue_guard(queue->lock);
+      queue->tasks.push_back(i);
+    }
+
+    generation++;
+  }
+  start.notify_all();
+
+  //  Work on the tasks too, then wait for the other threads to finish theirs
+  DoTasks(0);
+
+  std::unique_lock<std::mutex> guard(lock);
+  while (remaining > 0)
+    finish.wait(guard);
+
+} //==== ThreadPool::Run() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| ThreadPool::Work
+//|
+//| Purpose: This method is run by each thread of the pool.  It waits for Run to
+//|          start some tasks, works on them, and waits again.
+//|
+//| Parameters: worker: the number of this thread's queue
+//|_________________________________________________________________________________
+
+void ThreadPool::Work(long worker)
+{
+
+  unsigned long seen = 0;
+
+  while (true) {
+
+    {
+      std::unique_lock<std::mutex> guard(lock);
+      while (!quitting && (generation == seen))
+	start.wait(guard);
+      if (quitting)
+	return;
+      seen = generation;
+    }
+
+    DoTasks(worker);
+
+  }
+
+} //==== ThreadPool::Work() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| ThreadPool::DoTasks
+//|
+//| Purpose: This method runs tasks until there are none left to take.
+//|
+//| Parameters: worker: the number of this thread's queue
+//|_________________________________________________________________________________
+
+void ThreadPool::DoTasks(long worker)
+{
+
+  long index;
+  while (NextTask(worker, index)) {
+
+    //  The task was set before its numbers were queued, so it is safe to read here
+    running_task = true;
+    (*task)(index, task_data);
+    running_task = false;
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (--remaining == 0)
+      finish.notify_all();
+
+  }
+
+} //==== ThreadPool::DoTasks() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| ThreadPool::NextTask
+//|
+//| Purpose: This method takes the next task for a thread:  the first one in its
+//|          own queue, or failing that, the last one in some other thread's queue.
+//|
+//| Parameters: worker: the number of this thread's queue
+//|             index:  receives the number of the task
+//|             returns false if there are no tasks left
+//|_________________________________________________________________________________
+
+bool ThreadPool::NextTask(long worker, long& index)
+{
+
+  long num_queues = queues.size();
+
+  for (long i = 0; i < num_queues; i++) {
+
+    TaskQueue *queue = queues[(worker + i) % num_queues];
+    std::lock_guard<std::mutex> guard(queue->lock);
+
+    if (queue->tasks.empty())
+      continue;
+
+    if (i == 0) {
+      index = queue->tasks.front();
+      queue->tasks.pop_front();
+    }
+    else {
+      index = queue->tasks.back();
+      queue->tasks.pop_back();
+    }
+
+    return true;
+
+  }
+
+  return false;
+
+} //==== ThreadPool::NextTask() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| ThreadPool::GetThreadPool
+//|
+//| Purpose: This procedure returns the pool used by ADSODA, creating it with one
+//|          thread per processor if there isn't one yet.
+//|
+//| Parameters: returns the pool
+//|_________________________________________________________________________________
+
+ThreadPool *ThreadPool::GetThreadPool(void)
+{
+
+  if (thread_pool == NULL)
+    thread_pool = new ThreadPool(std::thread::hardware_concurrency());
+
+  return thread_pool;
+
+} //==== ThreadPool::GetThreadPool() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| ThreadPool::SetNumThreads
+//|
+//| Purpose: This procedure replaces the pool used by ADSODA with one which has
+//|          a different number of threads.
+//|
+//| Parameters: num_threads: the number of threads; 0 for one per processor
+//|_________________________________________________________________________________
+
+void ThreadPool::SetNumThreads(long num_threads)
+{
+
+  if (num_threads <= 0)
+    num_threads = std::thread::hardware_concurrency();
+
+  if (thread_pool && (thread_pool->NumThreads() == num_threads))
+    return;
+
+  delete(thread_pool);
+  thread_pool = new ThreadPool(num_threads);
+
+} //==== ThreadPool::SetNumThreads() ====//
@@ -0,0 +1,70 @@
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| ThreadPool.h
+//|
+//| This is the interface to the ThreadPool class.  A ThreadPool runs a numbered
+//| set of tasks on a fixed set of threads.  Each thread has its own queue of
+//| tasks; a thread whose queue is empty steals tasks from the others, so uneven
+//| tasks still keep every thread busy.  The thread which calls Run works on the
+//| tasks too, and Run returns when all of them are finished.
+//|_____________________________________________________________________________
+
+#ifndef HTHREADPOOL
+#define HTHREADPOOL
+
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+//  A task is called with its number, and with the data passed to Run
+typedef void (*ThreadTask)(long index, void *data);
+
+
+class ThreadPool
+{
+
+  //  The tasks waiting for one thread
+  class TaskQueue
+  {
+  public:
+    std::mutex lock;
+    std::deque<long> tasks;
+  };
+
+  std::vector<std::thread> threads;
+  std::vector<TaskQueue *> queues;
+
+  //  The tasks being run, and how many are not finished yet
+  std::mutex lock;
+  std::condition_variable start;
+  std::condition_variable finish;
+  ThreadTask task;
+  void *task_data;
+  long remaining;
+  unsigned long generation;
+  bool quitting;
+
+  void Work(long worker);
+  void DoTasks(long worker);
+  bool NextTask(long worker, long& index);
+
+  static ThreadPool *thread_pool;
+
+public:
+
+  ThreadPool(long num_threads);
+  ~ThreadPool(void);
+
+  long NumThreads(void) const;
+
+  void Run(long num_tasks, ThreadTask task, void *data);
+
+  static ThreadPool *GetThreadPool(void);
+  static void SetNumThreads(long num_threads);
+
+};
+
+#endif
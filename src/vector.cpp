@@ -6,8 +6,10 @@
 
 
 //#include "PtrList.h"
+#include "arena.h"
 #include "halfspace.h"
 #include "face.h"
+#include "kernels.h"
 #include "vector.h"
 #include "solve.h"
 
@@ -30,9 +32,8 @@ Vector::Vector(long dim)
   // Use the specified dimension
   dimension = dim;
 
-  // Allocate space for the coordinates
-  coordinates = (double *) malloc(dim * sizeof(double));
-  ASSERT(coordinates != NULL);
+  // Get space for the coordinates
+  AllocateCoordinates(dim);
 
 } //==== Vector::Vector() ====//
 
@@ -52,9 +53,8 @@ Vector::Vector(const Vector &v)
   // Make the new vector the same dimension as the other one
   dimension = v.dimension;
 	
-  // Allocate space for the coordinates
-  coordinates =	(double *) malloc(dimension * sizeof(double));
-  ASSERT(coordinates != NULL);
+  // Get space for the coordinates
+  AllocateCoordinates(dimension);
 
   // Copy the coordinates
   memmove(coordinates, v.coordinates, dimension * sizeof(double));
@@ -63,6 +63,38 @@ Vector::Vector(const Vector &v)
 
 
 
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Vector::Vector
+//|
+//| Purpose: This method creates a Vector from a temporary one.  If the temporary
+//|          allocated its coordinates, the new Vector takes them over.
+//|
+//| Parameters: vector: the temporary Vector
+//|_________________________________________________________________________________
+
+Vector::Vector(Vector &&v)
+{
+
+  dimension = v.dimension;
+
+  if (v.OwnsAllocatedCoordinates()) {
+
+    // Take the coordinates, and leave v nothing to free
+    coordinates = v.coordinates;
+    shared_coordinates = false;
+    v.coordinates = v.inline_coordinates;
+
+  }
+
+  else {
+    AllocateCoordinates(dimension);
+    memmove(coordinates, v.coordinates, dimension * sizeof(double));
+  }
+
+}  //==== Vector::Vector() ====//
+
+
+
 //|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //| Vector::~Vector
 //|
@@ -74,13 +106,114 @@ Vector::Vector(const Vector &v)
 Vector::~Vector(void)
 {
 
-  // Free memory used by coordinates
-  free(coordinates);
+  // Free memory used by coordinates, unless they belong to someone else
+  FreeCoordinates();
 	
 } //==== Vector::~Vector() ====//
 
 
 
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Vector::operator new
+//|
+//| Purpose: This method allocates memory for a Vector (or a Halfspace, Face or
+//|          Light), from the frame arena during a frame.
+//|
+//| Parameters: size: the size of the object
+//|             returns the memory for it
+//|_________________________________________________________________________________
+
+void *Vector::operator new(size_t size)
+{
+
+  return FrameArena::AllocateObject(size);
+
+} //==== Vector::operator new() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Vector::operator delete
+//|
+//| Purpose: This method frees the memory of a Vector.
+//|
+//| Parameters: object: the memory of the Vector
+//|_________________________________________________________________________________
+
+void Vector::operator delete(void *object)
+{
+
+  FrameArena::FreeObject(object);
+
+} //==== Vector::operator delete() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Vector::AllocateCoordinates
+//|
+//| Purpose: This method gets space for the coordinates of this Vector.  Up to
+//|          VECTOR_INLINE_SIZE coordinates are kept inside the Vector; only more
+//|          than that are allocated.
+//|
+//| Parameters: count: the number of coordinates
+//|_________________________________________________________________________________
+
+void Vector::AllocateCoordinates(long count)
+{
+
+  if (count <= VECTOR_INLINE_SIZE)
+    coordinates = inline_coordinates;
+
+  else {
+    coordinates = (double *) malloc(count * sizeof(double));
+    ASSERT(coordinates != NULL);
+  }
+
+  shared_coordinates = false;
+
+} //==== Vector::AllocateCoordinates() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Vector::FreeCoordinates
+//|
+//| Purpose: This method frees the coordinates of this Vector, if they were
+//|          allocated by it.
+//|
+//| Parameters: none
+//|_________________________________________________________________________________
+
+void Vector::FreeCoordinates(void)
+{
+
+  if (OwnsAllocatedCoordinates())
+    free(coordinates);
+
+} //==== Vector::FreeCoordinates() ====//
+
+
+
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Vector::OwnsAllocatedCoordinates
+//|
+//| Purpose: This method checks whether the coordinates of this Vector were
+//|          allocated by it, as opposed to being kept inside it or belonging to
+//|          something else.
+//|
+//| Parameters: returns true if this Vector allocated its coordinates
+//|_________________________________________________________________________________
+
+bool Vector::OwnsAllocatedCoordinates(void) const
+{
+
+  return (!shared_coordinates && (coordinates != inline_coordinates));
+
+} //==== Vector::OwnsAllocatedCoordinates() ====//
+
+
+
 //|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //| Vector::Dimension
 //|
@@ -111,10 +244,10 @@ double Vector::Magnitude(void) const
 {
   
   // Start the sum at 0
-  register double sum = 0;
+  double sum = 0;
 
   // Sum the squares of the coordinates
-  register long i;
+  long i;
   for (i = 0; i < dimension; i++)
     sum += coordinates[i]*coordinates[i];
 
@@ -137,10 +270,10 @@ void Vector::Normalize(void)
 {
 
   // Find the length of this Vector
-  register double length = Magnitude();
+  double length = Magnitude();
 
   // Divide all coordinates by the length
-  register long i;
+  long i;
   for (i = 0; i < dimension; i++)
     coordinates[i] /= length;
 	
@@ -163,16 +296,28 @@ void Vector::Normalize(void)
 bool Vector::IntersectHyperplanes(std::vector<Face *>& hyperplanes)
 {
 
-  // Allocate memory for a system of equations
-  Equation *system = (Equation *) malloc(dimension*sizeof(Equation));
-  ASSERT(system != NULL);
+  //  Small systems of equations are built on the stack
+  double rows[SOLVE_MAX_DIMENSION][SOLVE_MAX_DIMENSION+1];
+  Equation stack_system[SOLVE_MAX_DIMENSION];
+  Equation *system = stack_system;
+  bool small_system = (dimension <= SOLVE_MAX_DIMENSION);
+
+  // Otherwise allocate memory for a system of equations
+  if (!small_system) {
+    system = (Equation *) malloc(dimension*sizeof(Equation));
+    ASSERT(system != NULL);
+  }
 
-  register long i;
+  long i;
   for (i = 0; i < dimension; i++) {
 
     // Allocate space for one equation
-    system[i] = (Equation) malloc((dimension+1)*sizeof(double));
-    ASSERT(system[i] != NULL);
+    if (small_system)
+      system[i] = rows[i];
+    else {
+      system[i] = (Equation) malloc((dimension+1)*sizeof(double));
+      ASSERT(system[i] != NULL);
+    }
 
     double *coefficients = ((Hyperplane *) hyperplanes[i])->coordinates;
 
@@ -184,9 +329,11 @@ bool Vector::IntersectHyperplanes(std::vector<Face *>& hyperplanes)
   bool valid = SolveEquations(dimension, system, coordinates);
 	
   // Free the memory used by the system of equations
-  for (i = 0; i < dimension; i++)
-    free(system[i]);
-  free(system);
+  if (!small_system) {
+    for (i = 0; i < dimension; i++)
+      free(system[i]);
+    free(system);
+  }
   
   return (!valid);
 
@@ -219,12 +366,7 @@ bool Vector::InsideHalfspace(Halfspace& halfspace)
   //  The following code evaluates this inequality.
   //
 
-  double result = 0;
-  long i;
-  for(i = 0; i < dimension; i++)
-    result += coordinates[i] * halfspace.coordinates[i];
-
-  result += halfspace.coordinates[i];
+  double result = GetDimensionKernels(dimension)->evaluate(dimension, halfspace.coordinates, coordinates);
 	
   return (result > VERY_SMALL_NUM);
 
@@ -282,12 +424,7 @@ bool Vector::InsideOrOnHalfspace(Halfspace& halfspace)
   //  The following code evaluates the left side of this inequality.
   //
 
-  double result = 0;
-  long i;
-  for(i = 0; i < dimension; i++)
-    result += coordinates[i] * halfspace.coordinates[i];
-
-  result += halfspace.coordinates[i];
+  double result = GetDimensionKernels(dimension)->evaluate(dimension, halfspace.coordinates, coordinates);
 	
   return (result > -VERY_SMALL_NUM);
 
@@ -337,7 +474,7 @@ Vector operator+(const Vector &v1, const Vector &v2)
   Vector sum(v1.Dimension());
 	
   // Sum the vectors componentwise, and put the result in the new vector "sum"
-  register long i;
+  long i;
   for (i = 0; i < v1.Dimension(); i++)
     sum.coordinates[i] = v1.coordinates[i] + v2.coordinates[i];
 
@@ -364,7 +501,7 @@ Vector operator-(const Vector &v1, const Vector &v2)
   Vector difference(v1.Dimension());
 	
   // Subtract the vectors componentwise, and put the result in the new vector "difference"
-  register long i;
+  long i;
   for (i = 0; i < v1.Dimension(); i++)
     difference.coordinates[i] =	v1.coordinates[i] - v2.coordinates[i];
 	
@@ -389,8 +526,8 @@ double operator*(const Vector &v1, const Vector &v2)
 {
 
   // Compute the sum of the componentwise multiplications (the dot product)
-  register double dotProduct = 0;
-  register long i;
+  double dotProduct = 0;
+  long i;
   for (i = 0; i < v1.Dimension(); i++)
     dotProduct += v1.coordinates[i] * v2.coordinates[i];
 
@@ -415,10 +552,10 @@ Vector operator-(const Vector &v)
   Vector negative(v.Dimension());
 	
   // Negate v, and put the result in negative
-  register double *vCoordinate = v.coordinates;
-  register double *negativeCoordinate =	negative.coordinates;
+  double *vCoordinate = v.coordinates;
+  double *negativeCoordinate =	negative.coordinates;
 
-  register long i;
+  long i;
   for (i = 0; i < v.Dimension(); i++) {
     *negativeCoordinate = -(*vCoordinate);
 
@@ -451,6 +588,32 @@ void Vector::operator = (const Vector& v)
 
 
 
+//|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//| Vector operator =
+//|
+//| Purpose: This is the Vector assignment operator for temporaries.  this and v
+//|          must be the same size.  If both allocated their coordinates, they
+//|          just trade them.
+//|
+//| Parameters: v: the temporary Vector to assign to this
+//|_________________________________________________________________________________
+
+void Vector::operator = (Vector&& v)
+{
+
+  if (OwnsAllocatedCoordinates() && v.OwnsAllocatedCoordinates()) {
+    double *swap = coordinates;
+    coordinates = v.coordinates;
+    v.coordinates = swap;
+  }
+
+  else
+    memmove(coordinates, v.coordinates, dimension * sizeof(double));
+
+}  //==== Vector operator = ====//
+
+
+
 //|~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //| CrossProduct3D
 //|
@@ -18,6 +18,12 @@ class Halfspace;
 class PtrList;
 class Face;
 
+
+//  The largest number of coordinates a Vector keeps inside itself; larger
+//  Vectors allocate their coordinates
+#define VECTOR_INLINE_SIZE	8
+
+
 class Vector
 {
 
@@ -31,7 +37,11 @@ public:
   
   Vector(long dim);
   Vector(const Vector& vector);
+  Vector(Vector&& vector);
   ~Vector();
+
+  static void *operator new(size_t size);
+  static void operator delete(void *object);
   
   long Dimension(void) const;
   
@@ -48,6 +58,7 @@ public:
   bool InsideOrOnHalfspaces(std::vector<Halfspace *>& halfspaces);
   
   void operator= (const Vector &v);
+  void operator= (Vector &&v);
 
   friend Vector operator+(const Vector &v1, const Vector &v2);
   friend Vector operator-(const Vector &v1, const Vector &v2);
@@ -60,6 +71,17 @@ protected:
   
   long dimension;
 
+  //  true if coordinates point into storage owned by something else (the face
+  //  matrix of a Solid), so they must not be freed
+  bool shared_coordinates;
+
+  //  The coordinates, if there are no more than VECTOR_INLINE_SIZE of them
+  double inline_coordinates[VECTOR_INLINE_SIZE];
+
+  void AllocateCoordinates(long count);
+  void FreeCoordinates(void);
+  bool OwnsAllocatedCoordinates(void) const;
+
 };
 
 #endif